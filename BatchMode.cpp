@@ -0,0 +1,914 @@
+#include "BatchMode.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <iomanip>
+#include <algorithm>
+#include <climits>
+
+#include "Process.h"
+#include "ProcessTable.h"
+#include "Scheduler.h"
+#include "Utils.h"
+#include "WorkloadIO.h"
+#include "Streaming.h"
+#include "ResultSink.h"
+#include "Compare.h"
+#include "ThreadPool.h"
+#include "WorkloadGenerator.h"
+#include "Timeline.h"
+#include "Smp.h"
+#include "Replication.h"
+#include "Checkpoint.h"
+#include "TraceImport.h"
+
+using namespace std;
+
+// Exit codes reported to job scripts
+static const int EXIT_USAGE = 1;
+static const int EXIT_INPUT = 2;
+static const int EXIT_OUTPUT = 3;
+
+/**
+ * Exit code of a run once its output is written
+ * A run that succeeded but could not write all of its output (a full disk, a
+ * closed pipe) fails with EXIT_OUTPUT.
+ */
+static int outputStatus(int status, bool writeFailed) {
+    if (status != 0 || !writeFailed)
+        return status;
+    cerr << "[ERROR] cannot write the results to standard output\n";
+    return EXIT_OUTPUT;
+}
+
+static void printUsage() {
+    cerr << "Usage: simulator --algo <name> --input <file> [--quantum <n>] [--format <format>] [--timeline <file>]\n"
+         << "       simulator --algo <name> --input <file> --stream [--quantum <n>] [--format <format>]\n"
+         << "       simulator --algo <name> --input <file> --cpus <n> [--smp <mode>] [--quantum <n>] [--format <format>]\n"
+         << "       simulator --algo mlfq --input <file> [--mlfq-quanta <q0,q1,...>] [--boost <n>] [--aging <n>] [--format <format>]\n"
+         << "       simulator --algo cfs --input <file> [--cfs-latency <n>] [--cfs-granularity <n>] [--format <format>]\n"
+         << "       simulator --algo all --input <file> [--quantum <n>] [--threads <n>] [--format csv|table]\n"
+         << "       simulator --sweep <from>:<to>[:<step>] --input <file> [--threads <n>]\n"
+         << "       simulator --algo <name> --generate <count> [generator options] --replicate <k> [--ci-width <pct>]\n"
+         << "                 [--threads <n>] [--format csv|table]\n"
+         << "       simulator --algo <name> --input <file> --checkpoint <file> --checkpoint-every <t> [--resume <file>]\n"
+         << "       simulator --algo <name>|kernel|all --trace <file> [--trace-unit <ns>] [--format <format>]\n"
+         << "       simulator --trace <file> [--trace-unit <ns>] --output <text file>\n"
+         << "       simulator --convert <text file> --output <binary file>\n"
+         << "       simulator --generate <count> [generator options] --output <binary file>\n"
+         << "\n"
+         << "Algorithms: fcfs, sjf, priority, rr, srtf, priority-preemptive, mlq\n"
+         << "            all: run the seven in parallel and compare waiting/turnaround times\n"
+         << "Input: CSV/TSV lines of pid, arrival, burst [, priority [, queueType]],\n"
+         << "       or a binary workload created with --convert; a burst of the form\n"
+         << "       cpu/io/cpu/... alternates CPU and I/O bursts (text input only)\n"
+         << "Formats: csv (default), json, summary, table; results on stdout, errors on stderr\n"
+         << "--timeline: stream the run's Gantt segments (pid,start,end) to a CSV file\n"
+         << "--generate <count> can replace --input to run on a generated workload\n"
+         << "Generator options: --seed <n> --arrivals poisson|bursty --interarrival <mean>\n"
+         << "  --cluster-size <mean> --bursts uniform|exponential|pareto|bimodal\n"
+         << "  --mean-burst <mean> --pareto-shape <a> --long-burst <mean> --long-fraction <f>\n"
+         << "  --priorities <levels> --queue-mix <system>,<interactive>,<batch> --threads <n>\n"
+         << "  --io-bursts <n> (I/O bursts per process, default 0) --mean-io <mean>\n"
+         << "--sweep: run rr for every quantum in the range in parallel and write\n"
+         << "         quantum, avg waiting/turnaround time, context switches, switch overhead\n"
+         << "         and makespan as CSV\n"
+         << "--replicate: run the algorithm on k workloads seeded from --seed (the same k for every\n"
+         << "             algorithm) in parallel and report mean waiting/turnaround/response time with\n"
+         << "             95% confidence intervals; --ci-width stops early once every interval is at\n"
+         << "             most pct % of its mean wide (after at least 5 replications)\n"
+         << "--checkpoint: rewrite a binary checkpoint of the run every t simulated time units;\n"
+         << "              --resume continues a run from one with results identical to an\n"
+         << "              uninterrupted run (same algorithm, options and workload; the seven\n"
+         << "              menu algorithms without --timeline)\n"
+         << "--trace: rebuild the workload from a perf sched / ftrace text dump of sched_switch\n"
+         << "         and sched_wakeup events, one time unit per --trace-unit ns (default 1000);\n"
+         << "         --algo kernel reports what the kernel achieved, --algo all adds it to the\n"
+         << "         comparison, and --output saves the workload as text\n"
+         << "--stream: pull processes as they arrive and drop them once finished\n"
+         << "          (fcfs, sjf, priority, rr, mlq; input must be sorted by arrival)\n"
+         << "--algo mlfq: multi-level feedback queue; quanta per level, highest first (default 2,4,8),\n"
+         << "             --boost moves everything to the top level every n time units, --aging moves\n"
+         << "             a process up one level after waiting n time units (0 = off, the default)\n"
+         << "--algo cfs: completely fair scheduler, priority is the nice value (-20..19);\n"
+         << "            target latency (default 24) and minimum granularity (default 3)\n"
+         << "--switch-cost <n>: time every context switch costs before the next process runs\n"
+         << "--cache-warmup <n>: extra time when a process resumes after another one ran\n"
+         << "                    (both default 0; single-CPU runs, --algo all and --sweep)\n"
+         << "--cpus: simulate n CPUs (fcfs, sjf, priority, rr) and print per-CPU statistics\n"
+         << "        to stderr; --smp global|per-cpu|work-stealing (default work-stealing)\n"
+         << "Run without arguments for the interactive menu.\n";
+}
+
+static bool parsePositive(const string& text, int& value) {
+    char* end = nullptr;
+    long parsed = strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || parsed <= 0 || parsed > 2147483647L)
+        return false;
+    value = (int)parsed;
+    return true;
+}
+
+// Parses a number that must use the whole text
+static bool parseNumber(const string& text, double& value) {
+    char* end = nullptr;
+    value = strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0';
+}
+
+static bool parseCount(const string& text, size_t& value) {
+    char* end = nullptr;
+    unsigned long long parsed = strtoull(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || text[0] == '-' || parsed == 0)
+        return false;
+    value = (size_t)parsed;
+    return true;
+}
+
+/**
+ * Parses a quantum range "from:to" or "from:to:step" (step defaults to 1)
+ */
+static bool parseRange(const string& text, int& from, int& to, int& step) {
+    size_t first = text.find(':');
+    if (first == string::npos)
+        return false;
+    size_t second = text.find(':', first + 1);
+    step = 1;
+    if (!parsePositive(text.substr(0, first), from))
+        return false;
+    if (second == string::npos)
+        return parsePositive(text.substr(first + 1), to) && from <= to;
+    return parsePositive(text.substr(first + 1, second - first - 1), to)
+        && parsePositive(text.substr(second + 1), step) && from <= to;
+}
+
+// Parses a comma-separated list of positive integers
+static bool parsePositiveList(const string& text, vector<int>& values) {
+    values.clear();
+    size_t begin = 0;
+    while (true) {
+        size_t comma = text.find(',', begin);
+        int value;
+        if (!parsePositive(text.substr(begin, comma == string::npos ? string::npos : comma - begin), value))
+            return false;
+        values.push_back(value);
+        if (comma == string::npos)
+            return true;
+        begin = comma + 1;
+    }
+}
+
+// Parses a count that may be 0
+static bool parseNonNegative(const string& text, int& value) {
+    return text == "0" ? (value = 0, true) : parsePositive(text, value);
+}
+
+static bool isGeneratorOption(const string& arg) {
+    static const char* OPTIONS[] = {
+        "--seed", "--arrivals", "--interarrival", "--cluster-size", "--bursts", "--mean-burst",
+        "--pareto-shape", "--long-burst", "--long-fraction", "--priorities", "--queue-mix",
+        "--io-bursts", "--mean-io"
+    };
+    for (const char* option : OPTIONS) {
+        if (arg == option)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Applies one generator option (see isGeneratorOption)
+ * Ranges are checked later by validateGeneratorOptions.
+ *
+ * @return false if the value does not parse
+ */
+static bool parseGeneratorOption(const string& arg, const string& value, GeneratorOptions& options) {
+    if (arg == "--seed") {
+        char* end = nullptr;
+        options.seed = strtoull(value.c_str(), &end, 10);
+        return !value.empty() && *end == '\0';
+    }
+    if (arg == "--arrivals") {
+        if (value == "poisson") options.arrivals = POISSON_ARRIVALS;
+        else if (value == "bursty") options.arrivals = BURSTY_ARRIVALS;
+        else return false;
+        return true;
+    }
+    if (arg == "--bursts") {
+        if (value == "uniform") options.bursts = UNIFORM_BURSTS;
+        else if (value == "exponential") options.bursts = EXPONENTIAL_BURSTS;
+        else if (value == "pareto") options.bursts = PARETO_BURSTS;
+        else if (value == "bimodal") options.bursts = BIMODAL_BURSTS;
+        else return false;
+        return true;
+    }
+    if (arg == "--priorities")
+        return parsePositive(value, options.priorityLevels);
+    if (arg == "--io-bursts")
+        return parseNonNegative(value, options.ioBursts);
+    if (arg == "--queue-mix") {
+        size_t first = value.find(',');
+        size_t second = first == string::npos ? string::npos : value.find(',', first + 1);
+        return second != string::npos
+            && parseNumber(value.substr(0, first), options.queueMix[0])
+            && parseNumber(value.substr(first + 1, second - first - 1), options.queueMix[1])
+            && parseNumber(value.substr(second + 1), options.queueMix[2]);
+    }
+    if (arg == "--interarrival") return parseNumber(value, options.meanInterarrival);
+    if (arg == "--cluster-size") return parseNumber(value, options.meanClusterSize);
+    if (arg == "--mean-burst") return parseNumber(value, options.meanBurst);
+    if (arg == "--pareto-shape") return parseNumber(value, options.paretoShape);
+    if (arg == "--long-burst") return parseNumber(value, options.longBurst);
+    if (arg == "--long-fraction") return parseNumber(value, options.longFraction);
+    if (arg == "--mean-io") return parseNumber(value, options.meanIo);
+    return false;
+}
+
+// Where a run takes its workload from: a file, the generator or a scheduler trace
+struct WorkloadSpec {
+    string inputPath;
+    bool generate = false;
+    GeneratorOptions generator;
+    string tracePath;
+    TraceImportOptions trace;
+    int threadCount = 0;
+};
+
+// Algorithm names in the same order as the interactive menu (1-7)
+static const char* ALGORITHM_NAMES[] = {
+    "fcfs", "sjf", "priority", "rr", "srtf", "priority-preemptive", "mlq"
+};
+
+/**
+ * Maps an algorithm name (or its menu number) to the menu number
+ *
+ * @return 1-7, or 0 if the name is unknown
+ */
+static int findAlgorithm(const string& name) {
+    for (int i = 0; i < 7; i++) {
+        if (name == ALGORITHM_NAMES[i] || name == to_string(i + 1))
+            return i + 1;
+    }
+    return 0;
+}
+
+/**
+ * Creates the result sink for an output format name
+ *
+ * @return The sink writing to stdout, or nullptr if the format is unknown
+ */
+static unique_ptr<ResultSink> createSink(const string& format) {
+    if (format == "csv") return unique_ptr<ResultSink>(new CsvResultSink(stdout));
+    if (format == "json") return unique_ptr<ResultSink>(new JsonResultSink(stdout));
+    if (format == "summary") return unique_ptr<ResultSink>(new SummaryResultSink(stdout));
+    if (format == "table") return unique_ptr<ResultSink>(new TableResultSink(stdout));
+    return nullptr;
+}
+
+/**
+ * Loads a workload into a ProcessTable sorted by arrival time
+ * Generated and binary workloads are already sorted and go straight into the
+ * table; text workloads are parsed and sorted first; traces are imported
+ * (with their import counters on stderr).
+ *
+ * @param kernel If not null, receives the kernel's schedule of a trace workload
+ * @return false (after reporting the error) if the workload cannot be loaded
+ */
+static bool loadTable(const WorkloadSpec& spec, ProcessTable& table, ScheduleResult* kernel = nullptr) {
+    string error;
+    const string& inputPath = spec.tracePath.empty() ? spec.inputPath : spec.tracePath;
+    if (!spec.tracePath.empty()) {
+        ScheduleResult kernelResult;
+        TraceImportStats stats;
+        if (!importSchedTrace(spec.tracePath, spec.trace, table, kernel ? *kernel : kernelResult, stats, error)) {
+            cerr << "[ERROR] " << error << "\n";
+            return false;
+        }
+        printTraceImportStats(stats, spec.trace, stderr);
+    }
+    else if (spec.generate) {
+        ThreadPool pool((unsigned)spec.threadCount);
+        if (!generateWorkload(spec.generator, table, pool, error)) {
+            cerr << "[ERROR] " << error << "\n";
+            return false;
+        }
+    }
+    else if (isBinaryWorkload(inputPath)) {
+        MappedWorkload workload;
+        if (!workload.open(inputPath, error)) {
+            cerr << "[ERROR] " << error << "\n";
+            return false;
+        }
+        table.reserve(workload.size());
+        for (size_t i = 0; i < workload.size(); i++) {
+            if (!workload.checkRecord(i, error)) {
+                cerr << "[ERROR] " << error << "\n";
+                return false;
+            }
+            const WorkloadRecord& r = workload[i];
+            table.add(r.pid, r.arrivalTime, r.burstTime, r.priority, static_cast<QueueType>(r.queueType));
+        }
+    }
+    else {
+        vector<Process> processes;
+        if (!loadTextWorkload(inputPath, processes, error)) {
+            cerr << "[ERROR] " << error << "\n";
+            return false;
+        }
+        sortByArrivalTime(processes);
+        table.assign(processes);
+    }
+
+    if (table.empty()) {
+        cerr << "[ERROR] " << inputPath << " contains no processes\n";
+        return false;
+    }
+    if (table.makespanBound() > INT_MAX) {
+        cerr << "[ERROR] " << CLOCK_OVERFLOW_ERROR << "\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Runs a streaming scheduler straight from the workload file
+ * Results go to the sink in completion order, followed by a one-line
+ * summary (including the peak ready queue size) on stderr.
+ */
+static int runStreaming(int algoChoice, const string& inputPath, int timeQuantum, ResultSink& sink) {
+    if (algoChoice == 5 || algoChoice == 6) {
+        cerr << "Streaming mode supports fcfs, sjf, priority, rr and mlq\n";
+        return EXIT_USAGE;
+    }
+
+    string error;
+    MappedWorkload workload;
+    MappedProcessSource mappedSource(workload);
+    TextProcessSource textSource;
+    ProcessSource* source = &textSource;
+
+    if (isBinaryWorkload(inputPath)) {
+        if (!workload.open(inputPath, error)) {
+            cerr << "[ERROR] " << error << "\n";
+            return EXIT_INPUT;
+        }
+        source = &mappedSource;
+    }
+    else if (!textSource.open(inputPath, error)) {
+        cerr << "[ERROR] " << error << "\n";
+        return EXIT_INPUT;
+    }
+
+    StreamSummary summary;
+    switch (algoChoice) {
+    case 1: summary = StreamFCFS(*source, sink); break;
+    case 2: summary = StreamSJF_NonPreemptive(*source, sink); break;
+    case 3: summary = StreamPriority_NonPreemptive(*source, sink); break;
+    case 4: summary = StreamRoundRobin(*source, sink, timeQuantum); break;
+    case 7: summary = StreamMultiLevelQueue(*source, sink); break;
+    }
+
+    if (!source->error().empty()) {
+        cerr << "[ERROR] " << source->error() << "\n";
+        return EXIT_INPUT;
+    }
+
+    cerr << fixed << setprecision(2)
+         << "processes=" << summary.processCount
+         << " avg_turnaround=" << summary.turnaroundTime.mean()
+         << " avg_waiting=" << summary.waitingTime.mean()
+         << " p99_waiting=" << summary.waitingTime.quantile(0.99)
+         << " max_waiting=" << summary.waitingTime.max()
+         << " avg_response=" << summary.responseTime.mean()
+         << " p99_response=" << summary.responseTime.quantile(0.99)
+         << " makespan=" << summary.makespan
+         << " peak_ready_queue=" << summary.peakReadyQueue << "\n";
+    return 0;
+}
+
+/**
+ * Runs one algorithm on several simulated CPUs
+ * Results go to the sink, the per-CPU statistics to stderr.
+ */
+static int runMultiCpu(const WorkloadSpec& spec, const SmpOptions& options, ResultSink& sink) {
+    ProcessTable table;
+    if (!loadTable(spec, table))
+        return EXIT_INPUT;
+    if (table.hasIo()) {
+        cerr << "--cpus does not model I/O bursts\n";
+        return EXIT_USAGE;
+    }
+
+    ScheduleResult result;
+    SmpStats stats;
+    runSmp(table, options, result, stats);
+    reportResults(table, result, smpTitle(options), sink);
+    printSmpStats(stats, stderr);
+    return 0;
+}
+
+/**
+ * Runs every algorithm on the workload in parallel and writes one comparison
+ */
+static int runComparison(const WorkloadSpec& spec, int timeQuantum, const SwitchCost& switchCost, const string& format) {
+    if (format != "csv" && format != "table") {
+        cerr << "--algo all supports the csv and table formats\n";
+        return EXIT_USAGE;
+    }
+
+    ProcessTable table;
+    ScheduleResult kernel;
+    if (!loadTable(spec, table, &kernel))
+        return EXIT_INPUT;
+
+    ThreadPool pool((unsigned)spec.threadCount);
+    vector<AlgorithmStats> stats = compareAlgorithms(table, timeQuantum, switchCost, pool);
+    for (const AlgorithmStats& s : stats) {
+        if (s.clockOverflow) {
+            cerr << "[ERROR] " << s.title << ": " << CLOCK_OVERFLOW_ERROR << "\n";
+            return EXIT_INPUT;
+        }
+    }
+    if (!spec.tracePath.empty()) {
+        // What the kernel did with the same tasks, first
+        AlgorithmStats kernelStats = summarizeRun(table, kernel);
+        kernelStats.title = KERNEL_TRACE_TITLE;
+        stats.insert(stats.begin(), kernelStats);
+    }
+    if (format == "table")
+        printComparison(stats, stdout);
+    else
+        writeComparisonCsv(stats, stdout);
+    return outputStatus(0, fflush(stdout) != 0 || ferror(stdout));
+}
+
+/**
+ * Reports the schedule the kernel ran in a trace, per process like an algorithm run
+ */
+static int runKernelReport(const WorkloadSpec& spec, ResultSink& sink) {
+    ProcessTable table;
+    ScheduleResult kernel;
+    if (!loadTable(spec, table, &kernel))
+        return EXIT_INPUT;
+    reportResults(table, kernel, KERNEL_TRACE_TITLE, sink);
+    return 0;
+}
+
+/**
+ * Runs one single-CPU algorithm over independently seeded workloads in
+ * parallel and writes the confidence intervals
+ */
+static int runReplication(const ReplicationOptions& options, const ScheduleFunction& schedule, const string& title,
+    int threadCount, const string& format)
+{
+    if (format != "csv" && format != "table") {
+        cerr << "--replicate supports the csv and table formats\n";
+        return EXIT_USAGE;
+    }
+    string error;
+    if (!validateReplicationOptions(options, error)) {
+        cerr << error << "\n";
+        return EXIT_USAGE;
+    }
+
+    ThreadPool pool((unsigned)threadCount);
+    ReplicationReport report;
+    if (!runReplications(options, schedule, pool, report, error)) {
+        cerr << "[ERROR] " << error << "\n";
+        return EXIT_INPUT;
+    }
+    report.title = title;
+    if (format == "table")
+        printReplicationReport(report, stdout);
+    else
+        writeReplicationCsv(report, stdout);
+    return outputStatus(0, fflush(stdout) != 0 || ferror(stdout));
+}
+
+/**
+ * Runs Round Robin over a range of time quanta in parallel and writes the curve as CSV
+ */
+static int runQuantumSweep(const WorkloadSpec& spec, int from, int to, int step, const SwitchCost& switchCost) {
+    ProcessTable table;
+    if (!loadTable(spec, table))
+        return EXIT_INPUT;
+
+    ThreadPool pool((unsigned)spec.threadCount);
+    vector<QuantumPoint> points = sweepQuantum(table, from, to, step, switchCost, pool);
+    for (const QuantumPoint& point : points) {
+        if (point.clockOverflow) {
+            cerr << "[ERROR] quantum " << point.timeQuantum << ": " << CLOCK_OVERFLOW_ERROR << "\n";
+            return EXIT_INPUT;
+        }
+    }
+    writeQuantumSweepCsv(points, stdout);
+    return outputStatus(0, fflush(stdout) != 0 || ferror(stdout));
+}
+
+int runBatchMode(int argc, char* argv[]) {
+    string algo;
+    WorkloadSpec spec;
+    string& inputPath = spec.inputPath;
+    string convertPath;
+    string outputPath;
+    string format = "csv";
+    string timelinePath;
+    int timeQuantum = 2;
+    int sweepFrom = 0, sweepTo = 0, sweepStep = 1;
+    bool stream = false;
+    MlfqOptions mlfq;
+    CfsOptions cfs;
+    SwitchCost switchCost;
+    SmpOptions smp;
+    smp.cpuCount = 0;   // single CPU unless --cpus is given
+    bool smpModeGiven = false;
+    CheckpointOptions checkpointOptions;
+    ReplicationOptions replication;
+    replication.maxReplications = 0;   // no replication unless --replicate is given
+    bool ciWidthGiven = false;
+    bool traceUnitGiven = false;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        }
+        if (arg == "--stream") {
+            stream = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Missing value for " << arg << "\n";
+            printUsage();
+            return EXIT_USAGE;
+        }
+        string value = argv[++i];
+        if (arg == "--algo") algo = value;
+        else if (arg == "--input") inputPath = value;
+        else if (arg == "--format") format = value;
+        else if (arg == "--convert") convertPath = value;
+        else if (arg == "--output") outputPath = value;
+        else if (arg == "--timeline") timelinePath = value;
+        else if (arg == "--sweep") {
+            if (!parseRange(value, sweepFrom, sweepTo, sweepStep)) {
+                cerr << "Sweep range must be <from>:<to>[:<step>] with positive integers and from <= to\n";
+                return EXIT_USAGE;
+            }
+        }
+        else if (arg == "--trace") spec.tracePath = value;
+        else if (arg == "--trace-unit") {
+            int unit = 0;
+            if (!parsePositive(value, unit)) {
+                cerr << "Trace time unit must be a positive number of nanoseconds\n";
+                return EXIT_USAGE;
+            }
+            spec.trace.unitNanoseconds = unit;
+            traceUnitGiven = true;
+        }
+        else if (arg == "--generate") {
+            if (!parseCount(value, spec.generator.count)) {
+                cerr << "Process count must be a positive integer\n";
+                return EXIT_USAGE;
+            }
+            spec.generate = true;
+        }
+        else if (isGeneratorOption(arg)) {
+            if (!parseGeneratorOption(arg, value, spec.generator)) {
+                cerr << "Invalid value " << value << " for " << arg << "\n";
+                return EXIT_USAGE;
+            }
+        }
+        else if (arg == "--threads") {
+            if (!parsePositive(value, spec.threadCount)) {
+                cerr << "Thread count must be a positive integer\n";
+                return EXIT_USAGE;
+            }
+        }
+        else if (arg == "--mlfq-quanta") {
+            if (!parsePositiveList(value, mlfq.quanta)) {
+                cerr << "MLFQ quanta must be a comma-separated list of positive integers\n";
+                return EXIT_USAGE;
+            }
+        }
+        else if (arg == "--boost" || arg == "--aging") {
+            if (!parseNonNegative(value, arg == "--boost" ? mlfq.boostInterval : mlfq.agingThreshold)) {
+                cerr << arg << " must be a non-negative integer\n";
+                return EXIT_USAGE;
+            }
+        }
+        else if (arg == "--cfs-latency" || arg == "--cfs-granularity") {
+            if (!parsePositive(value, arg == "--cfs-latency" ? cfs.targetLatency : cfs.minGranularity)) {
+                cerr << arg << " must be a positive integer\n";
+                return EXIT_USAGE;
+            }
+        }
+        else if (arg == "--switch-cost" || arg == "--cache-warmup") {
+            if (!parseNonNegative(value, arg == "--switch-cost" ? switchCost.contextSwitch : switchCost.cacheWarmup)) {
+                cerr << arg << " must be a non-negative integer\n";
+                return EXIT_USAGE;
+            }
+        }
+        else if (arg == "--cpus") {
+            if (!parsePositive(value, smp.cpuCount)) {
+                cerr << "CPU count must be a positive integer\n";
+                return EXIT_USAGE;
+            }
+        }
+        else if (arg == "--smp") {
+            int mode = 0;
+            while (mode < 3 && value != SMP_QUEUE_MODE_NAMES[mode])
+                mode++;
+            if (mode == 3) {
+                cerr << "SMP mode must be global, per-cpu or work-stealing\n";
+                return EXIT_USAGE;
+            }
+            smp.queueMode = (SmpQueueMode)mode;
+            smpModeGiven = true;
+        }
+        else if (arg == "--checkpoint") checkpointOptions.path = value;
+        else if (arg == "--resume") checkpointOptions.resumePath = value;
+        else if (arg == "--checkpoint-every") {
+            int interval = 0;
+            if (!parsePositive(value, interval)) {
+                cerr << "Checkpoint interval must be a positive integer\n";
+                return EXIT_USAGE;
+            }
+            checkpointOptions.interval = interval;
+        }
+        else if (arg == "--replicate") {
+            if (!parsePositive(value, replication.maxReplications)) {
+                cerr << "Replication count must be a positive integer\n";
+                return EXIT_USAGE;
+            }
+        }
+        else if (arg == "--ci-width") {
+            if (!parseNumber(value, replication.ciWidth)) {
+                cerr << "Invalid value " << value << " for --ci-width\n";
+                return EXIT_USAGE;
+            }
+            ciWidthGiven = true;
+        }
+        else if (arg == "--quantum") {
+            if (!parsePositive(value, timeQuantum)) {
+                cerr << "Time quantum must be a positive integer\n";
+                return EXIT_USAGE;
+            }
+        }
+        else {
+            cerr << "Unknown option " << arg << "\n";
+            printUsage();
+            return EXIT_USAGE;
+        }
+    }
+
+    if (!convertPath.empty()) {
+        if (outputPath.empty()) {
+            printUsage();
+            return EXIT_USAGE;
+        }
+        string error;
+        if (!convertTextToBinary(convertPath, outputPath, error)) {
+            cerr << "[ERROR] " << error << "\n";
+            return EXIT_INPUT;
+        }
+        return 0;
+    }
+
+    if (!spec.tracePath.empty()) {
+        if (!inputPath.empty() || spec.generate || stream) {
+            cerr << "--trace replaces --input and --generate and cannot be combined with --stream\n";
+            return EXIT_USAGE;
+        }
+        if (algo.empty() && sweepFrom == 0) {
+            if (outputPath.empty()) {
+                printUsage();
+                return EXIT_USAGE;
+            }
+            ProcessTable table;
+            string error;
+            if (!loadTable(spec, table))
+                return EXIT_INPUT;
+            if (!saveTextWorkload(outputPath, table, error)) {
+                cerr << "[ERROR] " << error << "\n";
+                return EXIT_INPUT;
+            }
+            return 0;
+        }
+    }
+    else if (traceUnitGiven) {
+        cerr << "--trace-unit requires --trace\n";
+        return EXIT_USAGE;
+    }
+
+    if (spec.generate) {
+        string error;
+        if (!validateGeneratorOptions(spec.generator, error)) {
+            cerr << error << "\n";
+            return EXIT_USAGE;
+        }
+        if (!inputPath.empty() || stream) {
+            cerr << "--generate replaces --input and cannot be combined with --stream\n";
+            return EXIT_USAGE;
+        }
+        if (algo.empty() && sweepFrom == 0 && replication.maxReplications == 0) {
+            if (outputPath.empty()) {
+                printUsage();
+                return EXIT_USAGE;
+            }
+            ThreadPool pool((unsigned)spec.threadCount);
+            if (!generateWorkloadFile(spec.generator, outputPath, pool, error)) {
+                cerr << "[ERROR] " << error << "\n";
+                return EXIT_INPUT;
+            }
+            return 0;
+        }
+    }
+    bool hasWorkload = spec.generate || !inputPath.empty() || !spec.tracePath.empty();
+
+    if (!timelinePath.empty() && (sweepFrom > 0 || algo == "all" || stream || smp.cpuCount > 0)) {
+        cerr << "--timeline records a single-CPU algorithm run without --stream\n";
+        return EXIT_USAGE;
+    }
+    if (smpModeGiven && smp.cpuCount == 0) {
+        cerr << "--smp requires --cpus\n";
+        return EXIT_USAGE;
+    }
+    if (smp.cpuCount > 0 && (sweepFrom > 0 || algo == "all" || stream)) {
+        cerr << "--cpus runs a single algorithm without --stream\n";
+        return EXIT_USAGE;
+    }
+    bool checkpointing = !checkpointOptions.path.empty() || !checkpointOptions.resumePath.empty();
+    if (checkpointOptions.path.empty() != (checkpointOptions.interval == 0)) {
+        cerr << "--checkpoint and --checkpoint-every go together\n";
+        return EXIT_USAGE;
+    }
+    if (checkpointing && (sweepFrom > 0 || algo == "all" || stream || smp.cpuCount > 0
+        || replication.maxReplications > 0 || !timelinePath.empty())) {
+        cerr << "--checkpoint and --resume apply to a single-CPU run without --stream or --timeline\n";
+        return EXIT_USAGE;
+    }
+    if (ciWidthGiven && replication.maxReplications == 0) {
+        cerr << "--ci-width requires --replicate\n";
+        return EXIT_USAGE;
+    }
+    if (replication.maxReplications > 0 && (!spec.generate || sweepFrom > 0 || algo == "all" || stream
+        || smp.cpuCount > 0 || !timelinePath.empty())) {
+        cerr << "--replicate runs a single-CPU algorithm on --generate workloads\n";
+        return EXIT_USAGE;
+    }
+    if (!switchCost.isFree() && (stream || smp.cpuCount > 0)) {
+        cerr << "--switch-cost and --cache-warmup apply to single-CPU runs without --stream\n";
+        return EXIT_USAGE;
+    }
+
+    if (sweepFrom > 0) {
+        if (!hasWorkload || (!algo.empty() && findAlgorithm(algo) != 4) || stream) {
+            cerr << "--sweep runs rr on a whole --input file or generated workload\n";
+            printUsage();
+            return EXIT_USAGE;
+        }
+        return runQuantumSweep(spec, sweepFrom, sweepTo, sweepStep, switchCost);
+    }
+
+    if (algo.empty() || !hasWorkload) {
+        printUsage();
+        return EXIT_USAGE;
+    }
+    if (algo == "all") {
+        if (stream) {
+            cerr << "--algo all cannot be combined with --stream\n";
+            return EXIT_USAGE;
+        }
+        return runComparison(spec, timeQuantum, switchCost, format);
+    }
+    if (algo == "kernel") {
+        if (spec.tracePath.empty() || smp.cpuCount > 0 || checkpointing || replication.maxReplications > 0
+            || !timelinePath.empty() || !switchCost.isFree()) {
+            cerr << "--algo kernel reports the schedule recorded in a --trace, without run options\n";
+            return EXIT_USAGE;
+        }
+        unique_ptr<ResultSink> sink = createSink(format);
+        if (!sink) {
+            cerr << "Unknown format " << format << "\n";
+            return EXIT_USAGE;
+        }
+        int status = runKernelReport(spec, *sink);
+        return outputStatus(status, sink->failed());
+    }
+    // 0 selects one of the configurable algorithms (mlfq, cfs)
+    int algoChoice = 0;
+    if (algo == "mlfq" || algo == "cfs") {
+        if (stream || smp.cpuCount > 0) {
+            cerr << "--algo " << algo << " runs on a single CPU without --stream\n";
+            return EXIT_USAGE;
+        }
+        string error;
+        if (algo == "mlfq" ? !validateMlfqOptions(mlfq, error) : !validateCfsOptions(cfs, error)) {
+            cerr << error << "\n";
+            return EXIT_USAGE;
+        }
+    }
+    else if ((algoChoice = findAlgorithm(algo)) == 0) {
+        cerr << "Unknown algorithm " << algo << "\n";
+        printUsage();
+        return EXIT_USAGE;
+    }
+    if (checkpointing && algoChoice == 0) {
+        cerr << "--checkpoint and --resume support the seven menu algorithms\n";
+        return EXIT_USAGE;
+    }
+    unique_ptr<ResultSink> sink = createSink(format);
+    if (!sink) {
+        cerr << "Unknown format " << format << "\n";
+        return EXIT_USAGE;
+    }
+
+    if (stream) {
+        int status = runStreaming(algoChoice, inputPath, timeQuantum, *sink);
+        return outputStatus(status, sink->failed());
+    }
+
+    const char* title = algoChoice > 0 ? ALGORITHM_TITLES[algoChoice - 1] : algo == "mlfq" ? MLFQ_TITLE : CFS_TITLE;
+    // Runs the chosen single-CPU algorithm; the options are copied, so replications can share it
+    ScheduleFunction schedule = [algo, algoChoice, timeQuantum, mlfq, cfs](const ProcessTable& table, ScheduleResult& result) {
+        if (algo == "mlfq")
+            MultiLevelFeedbackQueue(table, result, mlfq);
+        else if (algo == "cfs")
+            CompletelyFair(table, result, cfs);
+        else
+            runAlgorithm(algoChoice, table, result, timeQuantum);
+    };
+
+    if (replication.maxReplications > 0) {
+        replication.generator = spec.generator;
+        replication.switchCost = switchCost;
+        replication.minReplications = min(replication.minReplications, replication.maxReplications);
+        return runReplication(replication, schedule, title, spec.threadCount, format);
+    }
+
+    if (smp.cpuCount > 0) {
+        smp.algorithm = algoChoice;
+        smp.timeQuantum = timeQuantum;
+        string error;
+        if (!validateSmpOptions(smp, error)) {
+            cerr << error << "\n";
+            return EXIT_USAGE;
+        }
+        int status = runMultiCpu(spec, smp, *sink);
+        return outputStatus(status, sink->failed());
+    }
+
+    ProcessTable table;
+    if (!loadTable(spec, table))
+        return EXIT_INPUT;
+
+    ScheduleResult result;
+    result.switchCost = switchCost;
+
+    // A checkpoint resumes only a run with the same algorithm and the parameters that change its course
+    checkpointOptions.runTag = ALGORITHM_NAMES[max(algoChoice, 1) - 1];
+    if (algoChoice == 4)
+        checkpointOptions.runTag += " quantum=" + to_string(timeQuantum);
+    if (!switchCost.isFree())
+        checkpointOptions.runTag += " switch-cost=" + to_string(switchCost.contextSwitch)
+            + " cache-warmup=" + to_string(switchCost.cacheWarmup);
+    RunCheckpoints checkpoints(checkpointOptions);
+    if (checkpointing)
+        result.checkpoints = &checkpoints;
+
+    Timeline timeline;
+    FILE* timelineFile = nullptr;
+    if (!timelinePath.empty()) {
+        timelineFile = openFile(timelinePath, "w");
+        if (!timelineFile) {
+            cerr << "[ERROR] cannot create " << timelinePath << "\n";
+            return EXIT_INPUT;
+        }
+        timeline.streamTo(timelineFile);
+        result.timeline = &timeline;
+    }
+
+    schedule(table, result);
+    if (checkpoints.failed()) {
+        cerr << "[ERROR] " << checkpoints.error() << "\n";
+        return EXIT_INPUT;
+    }
+    if (result.clockOverflow) {
+        cerr << "[ERROR] " << CLOCK_OVERFLOW_ERROR << "\n";
+        return EXIT_INPUT;
+    }
+
+    if (timelineFile) {
+        timeline.finish();
+        bool written = !timeline.failed();
+        if (fclose(timelineFile) != 0 || !written) {
+            cerr << "[ERROR] write error in " << timelinePath << "\n";
+            return EXIT_OUTPUT;
+        }
+    }
+    reportResults(table, result, title, *sink);
+    return outputStatus(0, sink->failed());
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+/**
+ * Runs the simulator non-interactively from command-line arguments
+ *
+ * Example: simulator --algo srtf --input workload.csv --quantum 4
+ *
+ * @return Process exit code (0 on success)
+ */
+int runBatchMode(int argc, char* argv[]);
@@ -3,10 +3,17 @@
 #include <limits>
 #include <string>
 #include <cstdlib>
+#include <climits>
+#include <algorithm>
 
 #include "Process.h"
 #include "Scheduler.h"
 #include "Utils.h"
+#include "BatchMode.h"
+#include "Compare.h"
+#include "ThreadPool.h"
+#include "ResultSink.h"
+#include "Timeline.h"
 
 #ifdef _WIN32
 #define NOMINMAX
@@ -118,13 +125,22 @@ void showAbout() {
     std::cout << "4. Round Robin (Time Quantum)\n";
     std::cout << "5. SJF (Shortest Job First) - Preemptive (SRTF)\n";
     std::cout << "6. Priority Scheduling - Preemptive\n";
-    std::cout << "7. Multi-Level Queue Scheduling\n\n";
+    std::cout << "7. Multi-Level Queue Scheduling\n";
+    std::cout << "8. Compare All (runs 1-7 in parallel on the same data)\n";
+    std::cout << "9. Round Robin Quantum Sweep (CSV of waiting/turnaround time, context switches and their cost)\n";
+    std::cout << "10. Multi-Level Feedback Queue (demotion, priority boost and aging)\n";
+    std::cout << "11. Completely Fair Scheduler (virtual runtime, priority as nice value)\n\n";
     std::cout << "Note: Ensure you enter processes before running simulation.\n";
     pauseConsole();
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     setupConsole();
+
+    // Any command-line arguments select the non-interactive batch mode
+    if (argc > 1)
+        return runBatchMode(argc, argv);
+
     std::vector<Process> originalProcesses;
     int choice;
 
@@ -166,30 +182,145 @@ int main() {
                 std::cout << "5. SJF (Preemptive)\n";
                 std::cout << "6. Priority (Preemptive)\n";
                 std::cout << "7. Multi-Level Queue Scheduling\n";
+                std::cout << "8. Compare All Algorithms\n";
+                std::cout << "9. Round Robin Quantum Sweep\n";
+                std::cout << "10. Multi-Level Feedback Queue\n";
+                std::cout << "11. Completely Fair Scheduler\n";
                 std::cout << "Enter choice: ";
                 
                 std::cin >> algoChoice;
+
+                if (algoChoice == 8) {
+                    int timeQuantum;
+                    std::cout << "Enter Time Quantum for Round Robin: ";
+                    if (!(std::cin >> timeQuantum) || timeQuantum <= 0) {
+                        std::cout << "Invalid Time Quantum! Must be a positive integer.\n";
+                        std::cin.clear();
+                        pauseConsole();
+                        break;
+                    }
+
+                    // Sort once; every algorithm shares the same read-only table
+                    std::vector<Process> sorted = originalProcesses;
+                    sortByArrivalTime(sorted);
+                    ProcessTable table(sorted);
+
+                    ThreadPool pool;
+                    printComparison(compareAlgorithms(table, timeQuantum, SwitchCost(), pool), stdout);
+                    pauseConsole();
+                    break;
+                }
+
+                if (algoChoice == 9) {
+                    int from, to, step;
+                    std::cout << "Smallest Time Quantum: ";
+                    std::cin >> from;
+                    std::cout << "Largest Time Quantum: ";
+                    std::cin >> to;
+                    std::cout << "Step: ";
+                    std::cin >> step;
+                    SwitchCost switchCost;
+                    std::cout << "Context Switch Cost (0 = free): ";
+                    std::cin >> switchCost.contextSwitch;
+                    if (!std::cin || from <= 0 || to < from || step <= 0 || switchCost.contextSwitch < 0) {
+                        std::cout << "Invalid range! Quanta and step must be positive and smallest <= largest, the switch cost non-negative.\n";
+                        std::cin.clear();
+                        pauseConsole();
+                        break;
+                    }
+
+                    std::vector<Process> sorted = originalProcesses;
+                    sortByArrivalTime(sorted);
+                    ProcessTable table(sorted);
+
+                    ThreadPool pool;
+                    std::cout << "\n";
+                    writeQuantumSweepCsv(sweepQuantum(table, from, to, step, switchCost, pool), stdout);
+                    pauseConsole();
+                    break;
+                }
                 
                 // Create a clean copy for simulation
                 std::vector<Process> simProcesses = originalProcesses;
                 // Pre-sort is often required by the logic
                 sortByArrivalTime(simProcesses);
                 
-                int timeQuantum;
+                MlfqOptions mlfq;
+                if (algoChoice == 10) {
+                    int levels, topQuantum;
+                    std::cout << "Number of Levels: ";
+                    std::cin >> levels;
+                    std::cout << "Top Level Time Quantum (doubles per level): ";
+                    std::cin >> topQuantum;
+                    std::cout << "Priority Boost Interval (0 = off): ";
+                    std::cin >> mlfq.boostInterval;
+                    std::cout << "Aging Threshold (0 = off): ";
+                    std::cin >> mlfq.agingThreshold;
 
-                switch (algoChoice) {
-                case 1: FCFS(simProcesses); break;
-                case 2: SJF_NonPreemptive(simProcesses); break;
-                case 3: Priority_NonPreemptive(simProcesses); break;
-                case 4: 
+                    std::string error;
+                    mlfq.quanta.clear();
+                    for (int level = 0; std::cin && level < levels && level < MLFQ_MAX_LEVELS; level++)
+                        mlfq.quanta.push_back((int)std::min<long long>((long long)topQuantum << std::min(level, 20), INT_MAX));
+                    if (!std::cin || !validateMlfqOptions(mlfq, error)) {
+                        std::cout << "Invalid MLFQ settings! " << error << "\n";
+                        std::cin.clear();
+                        pauseConsole();
+                        break;
+                    }
+                }
+
+                CfsOptions cfs;
+                if (algoChoice == 11) {
+                    std::cout << "Target Latency: ";
+                    std::cin >> cfs.targetLatency;
+                    std::cout << "Minimum Granularity: ";
+                    std::cin >> cfs.minGranularity;
+
+                    std::string error;
+                    if (!std::cin || !validateCfsOptions(cfs, error)) {
+                        std::cout << "Invalid CFS settings! " << error << "\n";
+                        std::cin.clear();
+                        pauseConsole();
+                        break;
+                    }
+                }
+
+                int timeQuantum = 0;
+                if (algoChoice == 4) {
                     std::cout << "Enter Time Quantum: ";
-                    std::cin >> timeQuantum;
-                    RoundRobin(simProcesses, timeQuantum); 
-                    break;
-                case 5: SJF_Preemptive(simProcesses); break;
-                case 6: Priority_Preemptive(simProcesses); break;
-                case 7: MultiLevelQueue(simProcesses); break;
-                default: std::cout << "Invalid Algorithm selection!\n"; break;
+                    if (!(std::cin >> timeQuantum) || timeQuantum <= 0) {
+                        std::cout << "Invalid Time Quantum! Must be a positive integer.\n";
+                        std::cin.clear();
+                        pauseConsole();
+                        break;
+                    }
+                }
+
+                // Record what ran when, for the Gantt chart
+                ProcessTable table(simProcesses);
+                ScheduleResult result;
+                Timeline timeline;
+                result.timeline = &timeline;
+
+                if (algoChoice == 10) {
+                    MultiLevelFeedbackQueue(table, result, mlfq);
+                    TableResultSink sink(stdout);
+                    reportResults(table, result, MLFQ_TITLE, sink);
+                    printGantt(timeline.segments(), stdout);
+                }
+                else if (algoChoice == 11) {
+                    CompletelyFair(table, result, cfs);
+                    TableResultSink sink(stdout);
+                    reportResults(table, result, CFS_TITLE, sink);
+                    printGantt(timeline.segments(), stdout);
+                }
+                else if (runAlgorithm(algoChoice, table, result, timeQuantum)) {
+                    TableResultSink sink(stdout);
+                    reportResults(table, result, ALGORITHM_TITLES[algoChoice - 1], sink);
+                    printGantt(timeline.segments(), stdout);
+                }
+                else {
+                    std::cout << "Invalid Algorithm selection!\n";
                 }
                 
                 pauseConsole();
@@ -0,0 +1,178 @@
+#include "Checkpoint.h"
+#include "Utils.h"
+#include <cstdio>
+
+using namespace std;
+
+static const uint64_t FNV_OFFSET = 0xCBF29CE484222325ull;
+static const uint64_t FNV_PRIME = 0x100000001B3ull;
+
+// Longest run tag accepted from a file
+static const uint32_t MAX_TAG_LENGTH = 4096;
+
+// Upper bound on the state size per process, against corrupted headers
+static const uint64_t MAX_STATE_BYTES_PER_PROCESS = 1024;
+
+static uint64_t fnv1a(const void* data, size_t size, uint64_t hash = FNV_OFFSET) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+template <typename T>
+static uint64_t hashVector(const vector<T>& values, uint64_t hash) {
+    return fnv1a(values.data(), values.size() * sizeof(T), hash);
+}
+
+RunCheckpoints::RunCheckpoints(const CheckpointOptions& options) : options(options), nextDue(options.interval) {}
+
+uint64_t RunCheckpoints::workloadHash(const ProcessTable& table) {
+    if (!tableHashed) {
+        uint64_t hash = FNV_OFFSET;
+        hash = hashVector(table.pid, hash);
+        hash = hashVector(table.arrivalTime, hash);
+        hash = hashVector(table.burstTime, hash);
+        hash = hashVector(table.priority, hash);
+        hash = hashVector(table.queueType, hash);
+        hash = hashVector(table.burstStart, hash);
+        hash = hashVector(table.bursts, hash);
+        tableHash = hash;
+        tableHashed = true;
+    }
+    return tableHash;
+}
+
+bool RunCheckpoints::write(const ProcessTable& table, int currentTime, const CheckpointWriter& state) {
+    const vector<char>& bytes = state.data();
+    CheckpointHeader header;
+    memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    header.version = CHECKPOINT_VERSION;
+    header.tagLength = (uint32_t)options.runTag.size();
+    header.processCount = table.size();
+    header.workloadHash = workloadHash(table);
+    header.stateSize = bytes.size();
+    header.stateHash = fnv1a(bytes.data(), bytes.size());
+
+    // Written beside the target and renamed over it, so the previous checkpoint survives a crash
+    string temporary = options.path + ".tmp";
+    FILE* file = openFile(temporary, "wb");
+    if (!file) {
+        failure = "cannot create " + temporary;
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+        && fwrite(options.runTag.data(), 1, options.runTag.size(), file) == options.runTag.size()
+        && fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    if (fclose(file) != 0)
+        ok = false;
+    if (!ok) {
+        remove(temporary.c_str());
+        failure = "write error in " + temporary;
+        return false;
+    }
+#ifdef _WIN32
+    // rename() does not replace an existing file on Windows
+    remove(options.path.c_str());
+#endif
+    if (rename(temporary.c_str(), options.path.c_str()) != 0) {
+        failure = "cannot replace " + options.path;
+        return false;
+    }
+
+    nextDue = (long long)currentTime + options.interval;
+    return true;
+}
+
+bool RunCheckpoints::read(const ProcessTable& table, CheckpointReader& state) {
+    const string& path = options.resumePath;
+    FILE* file = openFile(path, "rb");
+    if (!file) {
+        failure = "cannot open " + path;
+        return false;
+    }
+
+    CheckpointHeader header;
+    string tag;
+    vector<char> bytes;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1
+        && memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) == 0
+        && header.version == CHECKPOINT_VERSION && header.tagLength <= MAX_TAG_LENGTH;
+    if (ok) {
+        tag.resize(header.tagLength);
+        ok = fread(&tag[0], 1, tag.size(), file) == tag.size();
+    }
+    bool sameSize = ok && header.processCount == table.size();
+    if (sameSize) {
+        // Bounded before allocating it, the state must be exactly the rest of the file
+        ok = header.stateSize <= MAX_STATE_BYTES_PER_PROCESS * (table.size() + 1);
+        bytes.resize(ok ? (size_t)header.stateSize : 0);
+        ok = ok && fread(bytes.data(), 1, bytes.size(), file) == bytes.size() && fgetc(file) == EOF
+            && fnv1a(bytes.data(), bytes.size()) == header.stateHash;
+    }
+    fclose(file);
+
+    if (!ok)
+        failure = path + " is not a complete version " + to_string(CHECKPOINT_VERSION) + " checkpoint";
+    else if (tag != options.runTag)
+        failure = path + " was written by another run (" + tag + ", this run is " + options.runTag + ")";
+    else if (!sameSize || header.workloadHash != workloadHash(table))
+        failure = path + " was written for another workload";
+    if (failed())
+        return false;
+    state = CheckpointReader(move(bytes));
+    return true;
+}
+
+void saveResultState(const ScheduleResult& result, CheckpointWriter& state) {
+    state.putVector(result.remainingTime);
+    state.putVector(result.completionTime);
+    state.putVector(result.turnaroundTime);
+    state.putVector(result.waitingTime);
+    state.putVector(result.startTime);
+    state.putVector(result.responseTime);
+    state.put(result.contextSwitches);
+    state.put(result.lastDispatched);
+    state.put(result.overheadTime);
+    state.putVector(result.nextBurst);
+    vector<int> blocked;   // (time, process) pairs, flattened in heap order
+    for (const pair<int, int>& entry : result.blocked) {
+        blocked.push_back(entry.first);
+        blocked.push_back(entry.second);
+    }
+    state.putVector(blocked);
+    state.put(result.ioBusyTime);
+    state.put(result.ioOverlapTime);
+    state.put(result.ioEnd);
+}
+
+bool loadResultState(const ProcessTable& table, CheckpointReader& state, ScheduleResult& result) {
+    size_t n = table.size();
+    vector<int> blocked;
+    bool ok = state.getVector(result.remainingTime, n)
+        && state.getVector(result.completionTime, n)
+        && state.getVector(result.turnaroundTime, n)
+        && state.getVector(result.waitingTime, n)
+        && state.getVector(result.startTime, n)
+        && state.getVector(result.responseTime, n)
+        && state.get(result.contextSwitches)
+        && state.get(result.lastDispatched)
+        && state.get(result.overheadTime)
+        && state.getVector(result.nextBurst, n)
+        && state.getVector(blocked, 2 * n) && blocked.size() % 2 == 0
+        && state.get(result.ioBusyTime)
+        && state.get(result.ioOverlapTime)
+        && state.get(result.ioEnd);
+    result.blocked.clear();
+    for (size_t k = 0; ok && k < blocked.size(); k += 2) {
+        ok = blocked[k + 1] >= 0 && blocked[k + 1] < (int)n;
+        result.blocked.push_back(make_pair(blocked[k], blocked[k + 1]));
+    }
+    return ok && result.remainingTime.size() == n && result.completionTime.size() == n
+        && result.turnaroundTime.size() == n && result.waitingTime.size() == n
+        && result.startTime.size() == n && result.responseTime.size() == n
+        && result.nextBurst.size() == (table.hasIo() ? n : 0)
+        && result.lastDispatched >= -1 && result.lastDispatched < (int)n;
+}
@@ -0,0 +1,156 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include "ProcessTable.h"
+
+// Checkpoint file layout (native little-endian):
+//   CheckpointHeader, the run tag (header.tagLength bytes), then the state
+//   (header.stateSize bytes) as written by the engine through a CheckpointWriter
+const char CHECKPOINT_MAGIC[8] = { 'C', 'P', 'U', 'S', 'C', 'K', 'P', 'T' };
+const uint32_t CHECKPOINT_VERSION = 1;
+
+struct CheckpointHeader {
+    char magic[8];           // CHECKPOINT_MAGIC
+    uint32_t version;        // CHECKPOINT_VERSION
+    uint32_t tagLength;      // bytes of the run tag
+    uint64_t processCount;   // size of the table the run schedules
+    uint64_t workloadHash;   // FNV-1a of the table's fields
+    uint64_t stateSize;      // bytes of state after the tag
+    uint64_t stateHash;      // FNV-1a of the state, catches a torn or corrupted file
+};
+
+static_assert(sizeof(CheckpointHeader) == 48, "CheckpointHeader must stay 48 bytes");
+
+/**
+ * Append-only buffer the engine serializes its state into
+ * Values are copied as raw bytes, so T must be trivially copyable.
+ */
+class CheckpointWriter {
+public:
+    template <typename T>
+    void put(const T& value) {
+        const char* p = reinterpret_cast<const char*>(&value);
+        bytes.insert(bytes.end(), p, p + sizeof(T));
+    }
+
+    // Element count, then the elements
+    template <typename T>
+    void putVector(const std::vector<T>& values) {
+        put((uint64_t)values.size());
+        const char* p = reinterpret_cast<const char*>(values.data());
+        bytes.insert(bytes.end(), p, p + values.size() * sizeof(T));
+    }
+
+    const std::vector<char>& data() const { return bytes; }
+
+private:
+    std::vector<char> bytes;
+};
+
+/**
+ * Reads back what a CheckpointWriter wrote
+ * Every read fails (returns false) once the data runs out.
+ */
+class CheckpointReader {
+public:
+    CheckpointReader() {}
+    explicit CheckpointReader(std::vector<char> data) : bytes(std::move(data)) {}
+
+    template <typename T>
+    bool get(T& value) {
+        if (bytes.size() - position < sizeof(T))
+            return false;
+        memcpy(&value, bytes.data() + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+
+    // Reads a vector written by putVector; fails if it holds more than maxCount elements
+    template <typename T>
+    bool getVector(std::vector<T>& values, size_t maxCount) {
+        uint64_t count;
+        if (!get(count) || count > maxCount || (bytes.size() - position) / sizeof(T) < count)
+            return false;
+        values.resize((size_t)count);
+        memcpy(values.data(), bytes.data() + position, (size_t)count * sizeof(T));
+        position += (size_t)count * sizeof(T);
+        return true;
+    }
+
+    bool atEnd() const { return position == bytes.size(); }
+
+private:
+    std::vector<char> bytes;
+    size_t position = 0;
+};
+
+/**
+ * Where and how often a table-based run checkpoints, and what it resumes from
+ */
+struct CheckpointOptions {
+    std::string path;          // checkpoint file, rewritten at every checkpoint ("" = no checkpoints)
+    long long interval = 0;    // simulated time units between checkpoints
+    std::string resumePath;    // checkpoint to resume from ("" = start from time 0)
+    std::string runTag;        // algorithm and parameters; a checkpoint only resumes a run with the same tag
+};
+
+/**
+ * Checkpoint files of one run, attached to ScheduleResult::checkpoints
+ *
+ * The engine (runPolicy, see SchedulingEngine.h) serializes its loop state,
+ * the ScheduleResult and the policy's ready structures; this class adds the
+ * header, writes the file and checks a resumed file against the run. A file
+ * is written next to the target and renamed over it, so a crash while
+ * writing leaves the previous checkpoint intact.
+ */
+class RunCheckpoints {
+public:
+    explicit RunCheckpoints(const CheckpointOptions& options);
+
+    bool resuming() const { return !options.resumePath.empty(); }
+
+    // Whether a checkpoint is due at the given simulated time
+    bool due(int currentTime) const { return !options.path.empty() && currentTime >= nextDue; }
+
+    /**
+     * Writes a checkpoint of the state taken at currentTime
+     *
+     * @return false (with error() set) if the file cannot be written
+     */
+    bool write(const ProcessTable& table, int currentTime, const CheckpointWriter& state);
+
+    /**
+     * Reads options.resumePath and checks that it belongs to this run and table
+     *
+     * @param state Receives the engine state stored in the file
+     * @return false (with error() set) on a missing, foreign or corrupted file
+     */
+    bool read(const ProcessTable& table, CheckpointReader& state);
+
+    // Schedules the next checkpoint one interval after a resumed checkpoint's time
+    void resumedAt(int currentTime) { nextDue = currentTime + options.interval; }
+
+    // Sets the error of a run abandoned because of its checkpoints
+    void fail(const std::string& message) { failure = message; }
+
+    bool failed() const { return !failure.empty(); }
+    const std::string& error() const { return failure; }
+
+private:
+    uint64_t workloadHash(const ProcessTable& table);
+
+    CheckpointOptions options;
+    long long nextDue = 0;
+    uint64_t tableHash = 0;
+    bool tableHashed = false;
+    std::string failure;
+};
+
+// Appends the per-run state and partial metrics of a ScheduleResult
+void saveResultState(const ScheduleResult& result, CheckpointWriter& state);
+
+// Restores what saveResultState wrote for the same table; false on a size mismatch
+bool loadResultState(const ProcessTable& table, CheckpointReader& state, ScheduleResult& result);
@@ -0,0 +1,159 @@
+#include "Compare.h"
+#include "Scheduler.h"
+#include "ResultSink.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+AlgorithmStats summarizeRun(const ProcessTable& table, const ScheduleResult& result) {
+    AlgorithmStats stats;
+    size_t n = table.size();
+    stats.processCount = n;
+    stats.contextSwitches = result.contextSwitches;
+    stats.switchOverhead = result.overheadTime;
+    stats.clockOverflow = result.clockOverflow;
+    if (result.ioBusyTime > 0)
+        stats.ioOverlap = 100.0 * result.ioOverlapTime / result.ioBusyTime;
+
+    int makespan = 0;
+    long long cpuTime = 0;
+    QuantileSketch waiting, turnaround, response;
+    double totalSlowdown = 0.0, totalSquaredSlowdown = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        waiting.add(result.waitingTime[i]);
+        turnaround.add(result.turnaroundTime[i]);
+        response.add(result.responseTime[i]);
+
+        double slowdown = (double)result.turnaroundTime[i] / table.burstTime[i];
+        totalSlowdown += slowdown;
+        totalSquaredSlowdown += slowdown * slowdown;
+        stats.maxSlowdown = max(stats.maxSlowdown, slowdown);
+        makespan = max(makespan, result.completionTime[i]);
+        cpuTime += table.burstTime[i];
+    }
+    if (makespan > 0)
+        stats.cpuUtilization = 100.0 * cpuTime / ((double)makespan * result.cpuCount);
+    if (n > 0)
+        stats.averageSlowdown = totalSlowdown / n;
+    stats.fairnessIndex = jainIndex(totalSlowdown, totalSquaredSlowdown, (long long)n);
+    stats.waiting = summarize(waiting);
+    stats.turnaround = summarize(turnaround);
+    stats.response = summarize(response);
+    return stats;
+}
+
+vector<AlgorithmStats> compareAlgorithms(const ProcessTable& table, int timeQuantum, const SwitchCost& switchCost,
+    ThreadPool& pool)
+{
+    if (timeQuantum < 1)
+        return vector<AlgorithmStats>();
+    vector<AlgorithmStats> stats(7);
+
+    for (int algo = 1; algo <= 7; algo++) {
+        AlgorithmStats* slot = &stats[algo - 1];
+        pool.submit([&table, timeQuantum, switchCost, algo, slot]() {
+            ScheduleResult result;
+            result.switchCost = switchCost;
+
+            auto start = chrono::steady_clock::now();
+            runAlgorithm(algo, table, result, timeQuantum);
+            auto stop = chrono::steady_clock::now();
+
+            *slot = summarizeRun(table, result);
+            slot->algorithm = algo;
+            slot->title = ALGORITHM_TITLES[algo - 1];
+            slot->wallMilliseconds = chrono::duration<double, milli>(stop - start).count();
+        });
+    }
+
+    pool.wait();
+    return stats;
+}
+
+void printComparison(const vector<AlgorithmStats>& stats, FILE* out) {
+    size_t processCount = stats.empty() ? 0 : stats[0].processCount;
+    fprintf(out, "\n  Algorithm Comparison (%zu processes)\n\n", processCount);
+    fprintf(out, "  %-26s %12s %9s %9s %9s %9s %9s %12s %9s %9s %12s %9s %9s %6s %11s %11s %6s %7s %10s\n",
+        "Algorithm", "Avg Wait", "P50", "P90", "P99", "P99.9", "Max",
+        "Avg TAT", "P50", "P99", "Avg Resp", "P99", "Slowdown", "Jain", "Switches", "Overhead", "CPU %", "I/O ov%",
+        "Wall ms");
+    fprintf(out, "  %s\n", string(26 + 13 * 3 + 10 * 9 + 7 + 12 * 2 + 7 + 8 + 11, '-').c_str());
+    for (const auto& s : stats) {
+        fprintf(out, "  %-26s %12.2f %9d %9d %9d %9d %9d %12.2f %9d %9d %12.2f %9d %9.2f %6.3f %11lld %11lld %6.1f %7.1f %10.2f\n",
+            s.title.c_str(), s.waiting.mean, s.waiting.p50, s.waiting.p90, s.waiting.p99, s.waiting.p999,
+            s.waiting.max, s.turnaround.mean, s.turnaround.p50, s.turnaround.p99,
+            s.response.mean, s.response.p99, s.averageSlowdown, s.fairnessIndex, s.contextSwitches, s.switchOverhead,
+            s.cpuUtilization, s.ioOverlap, s.wallMilliseconds);
+    }
+    fprintf(out, "\n");
+    fflush(out);
+}
+
+// Appends the columns of one metric to a comparison CSV row
+static void writeSummaryColumns(const QuantileSummary& s, FILE* out) {
+    fprintf(out, ",%.2f,%d,%d,%d,%d,%d", s.mean, s.p50, s.p90, s.p99, s.p999, s.max);
+}
+
+void writeComparisonCsv(const vector<AlgorithmStats>& stats, FILE* out) {
+    fputs("algorithm,processes", out);
+    for (const char* metric : { "waiting", "turnaround", "response" })
+        fprintf(out, ",avg_%s,p50_%s,p90_%s,p99_%s,p999_%s,max_%s", metric, metric, metric, metric, metric, metric);
+    fputs(",avg_slowdown,max_slowdown,jain_fairness,context_switches,switch_overhead"
+        ",cpu_utilization_pct,io_overlap_pct,wall_ms\n", out);
+    for (const auto& s : stats) {
+        fprintf(out, "\"%s\",%zu", s.title.c_str(), s.processCount);
+        writeSummaryColumns(s.waiting, out);
+        writeSummaryColumns(s.turnaround, out);
+        writeSummaryColumns(s.response, out);
+        fprintf(out, ",%.2f,%.2f,%.4f,%lld,%lld,%.2f,%.2f,%.3f\n", s.averageSlowdown, s.maxSlowdown, s.fairnessIndex,
+            s.contextSwitches, s.switchOverhead, s.cpuUtilization, s.ioOverlap, s.wallMilliseconds);
+    }
+    fflush(out);
+}
+
+vector<QuantumPoint> sweepQuantum(const ProcessTable& table, int from, int to, int step, const SwitchCost& switchCost,
+    ThreadPool& pool)
+{
+    vector<QuantumPoint> points;
+    for (long long q = from; q <= to; q += step) {
+        QuantumPoint point;
+        point.timeQuantum = (int)q;
+        points.push_back(point);
+    }
+
+    size_t n = table.size();
+    for (QuantumPoint& point : points) {
+        QuantumPoint* slot = &point;
+        pool.submit([&table, n, switchCost, slot]() {
+            ScheduleResult result;
+            result.switchCost = switchCost;
+            RoundRobin(table, result, slot->timeQuantum);
+
+            long long totalWaiting = 0, totalTurnaround = 0;
+            for (size_t i = 0; i < n; i++) {
+                totalWaiting += result.waitingTime[i];
+                totalTurnaround += result.turnaroundTime[i];
+                slot->makespan = max(slot->makespan, result.completionTime[i]);
+            }
+            if (n > 0) {
+                slot->averageWaitingTime = (double)totalWaiting / n;
+                slot->averageTurnaroundTime = (double)totalTurnaround / n;
+            }
+            slot->contextSwitches = result.contextSwitches;
+            slot->switchOverhead = result.overheadTime;
+            slot->clockOverflow = result.clockOverflow;
+        });
+    }
+
+    pool.wait();
+    return points;
+}
+
+void writeQuantumSweepCsv(const vector<QuantumPoint>& points, FILE* out) {
+    fprintf(out, "quantum,avg_waiting,avg_turnaround,context_switches,switch_overhead,makespan\n");
+    for (const auto& p : points)
+        fprintf(out, "%d,%.2f,%.2f,%lld,%lld,%d\n", p.timeQuantum, p.averageWaitingTime, p.averageTurnaroundTime,
+            p.contextSwitches, p.switchOverhead, p.makespan);
+    fflush(out);
+}
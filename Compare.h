@@ -0,0 +1,79 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdio>
+#include "ProcessTable.h"
+#include "ThreadPool.h"
+#include "QuantileSketch.h"
+
+// Waiting, turnaround, response time and fairness statistics of one algorithm on a workload
+struct AlgorithmStats {
+    int algorithm = 0;               // menu number 1-7
+    std::string title;
+    size_t processCount = 0;
+
+    QuantileSummary waiting;
+    QuantileSummary turnaround;
+    QuantileSummary response;
+
+    double averageSlowdown = 0.0;    // turnaround / burst
+    double maxSlowdown = 0.0;
+    double fairnessIndex = 1.0;      // Jain's index over the slowdowns
+
+    long long contextSwitches = 0;
+    long long switchOverhead = 0;    // time lost to switching (see SwitchCost)
+    double cpuUtilization = 0.0;     // % of the makespan spent running processes, averaged over the CPUs
+    double ioOverlap = 0.0;          // % of the I/O busy time the CPU was busy too (0 without I/O)
+    double wallMilliseconds = 0.0;   // time spent in the scheduling run itself
+    bool clockOverflow = false;      // the run stopped at INT_MAX (see ScheduleResult::fitsClock)
+};
+
+/**
+ * Runs all seven algorithms on one workload in parallel
+ *
+ * The table is shared read-only by every run; each task owns its own
+ * ScheduleResult and reduces it to an AlgorithmStats before returning.
+ *
+ * @param table Workload sorted by arrival time
+ * @param timeQuantum Round Robin time quantum (at least 1)
+ * @param switchCost Overhead charged for every context switch
+ * @param pool Pool running one task per algorithm
+ * @return Statistics in menu order; empty (nothing is run) if timeQuantum is below 1
+ */
+std::vector<AlgorithmStats> compareAlgorithms(const ProcessTable& table, int timeQuantum, const SwitchCost& switchCost,
+    ThreadPool& pool);
+
+// Reduces a finished run to its statistics (percentiles come from fixed-memory sketches)
+AlgorithmStats summarizeRun(const ProcessTable& table, const ScheduleResult& result);
+
+// Writes the comparison as an aligned text table
+void printComparison(const std::vector<AlgorithmStats>& stats, FILE* out);
+
+// Writes the comparison as CSV, one row per algorithm
+void writeComparisonCsv(const std::vector<AlgorithmStats>& stats, FILE* out);
+
+// Round Robin metrics at one time quantum
+struct QuantumPoint {
+    int timeQuantum = 0;
+    double averageWaitingTime = 0.0;
+    double averageTurnaroundTime = 0.0;
+    long long contextSwitches = 0;
+    long long switchOverhead = 0;
+    int makespan = 0;
+    bool clockOverflow = false;
+};
+
+/**
+ * Runs Round Robin for every quantum from..to (inclusive) in steps of step
+ *
+ * One pool task per quantum; the table is shared, not copied, and each task
+ * only keeps its ScheduleResult while it runs. With a non-zero switchCost,
+ * small quanta pay for their extra switches in waiting time and makespan.
+ *
+ * @return One point per quantum, in increasing quantum order
+ */
+std::vector<QuantumPoint> sweepQuantum(const ProcessTable& table, int from, int to, int step, const SwitchCost& switchCost,
+    ThreadPool& pool);
+
+// Writes the sweep as CSV: quantum, average waiting/turnaround time, context switches, switch overhead, makespan
+void writeQuantumSweepCsv(const std::vector<QuantumPoint>& points, FILE* out);
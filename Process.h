@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <vector>
 
 enum QueueType {
     SYSTEM,        // High priority
@@ -12,27 +14,47 @@ struct Process {
     int pid;               // unique process ID
 
     int arrivalTime;       // time when process enters ready queue
-    int burstTime;         // total CPU execution time
+    int burstTime;         // total CPU execution time (sum of the CPU bursts)
+    int ioTime;            // total I/O time (0 for a pure CPU process)
     int remainingTime;     // used for preemptive algorithms (RR, SJF preemptive)
     int priority;          // lower value = higher priority (assumption)
 
     int waitingTime;       // total time spent waiting in ready queue
     int turnaroundTime;    // completionTime - arrivalTime
     int completionTime;    // time when process finishes execution
+    int startTime;         // start of the first slice it runs (-1 until the process first runs)
+    int responseTime;      // startTime - arrivalTime
 
     QueueType queueType;
 
+    // CPU and I/O bursts alternating, starting and ending with CPU (cpu, io, cpu, ...);
+    // empty for a single CPU burst of burstTime
+    std::vector<int> bursts;
+
 
     Process(int pid, int at, int bt, int prio, QueueType qt)
         : pid(pid),
         arrivalTime(at),
         burstTime(bt),
+        ioTime(0),
         remainingTime(bt),
         priority(prio),
         queueType(qt),
         waitingTime(0),
         turnaroundTime(0),
-        completionTime(0) {
+        completionTime(0),
+        startTime(-1),
+        responseTime(0) {
+    }
+
+    // Replaces the single CPU burst with a CPU/I-O sequence (odd length, all positive)
+    void setBursts(const std::vector<int>& sequence) {
+        bursts = sequence;
+        burstTime = 0;
+        ioTime = 0;
+        for (size_t k = 0; k < sequence.size(); k++)
+            (k % 2 == 0 ? burstTime : ioTime) += sequence[k];
+        remainingTime = burstTime;
     }
 
 };
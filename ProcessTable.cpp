@@ -0,0 +1,161 @@
+#include "ProcessTable.h"
+
+using namespace std;
+
+const char* const CLOCK_OVERFLOW_ERROR = "simulated time exceeds the int range; shorten the workload or its switch costs";
+
+void ProcessTable::clear() {
+    arrivalTime.clear();
+    burstTime.clear();
+    priority.clear();
+    pid.clear();
+    queueType.clear();
+    burstStart.clear();
+    bursts.clear();
+    ioTime.clear();
+}
+
+void ProcessTable::reserve(size_t n) {
+    arrivalTime.reserve(n);
+    burstTime.reserve(n);
+    priority.reserve(n);
+    pid.reserve(n);
+    queueType.reserve(n);
+}
+
+void ProcessTable::resize(size_t n) {
+    arrivalTime.resize(n);
+    burstTime.resize(n);
+    priority.resize(n);
+    pid.resize(n);
+    queueType.resize(n, BATCH);
+}
+
+void ProcessTable::add(int id, int at, int bt, int prio, QueueType qt) {
+    pid.push_back(id);
+    arrivalTime.push_back(at);
+    burstTime.push_back(bt);
+    priority.push_back(prio);
+    queueType.push_back(qt);
+    if (hasIo()) {
+        bursts.push_back(bt);
+        burstStart.push_back((int)bursts.size());
+        ioTime.push_back(0);
+    }
+}
+
+void ProcessTable::add(int id, int at, const int* sequence, size_t count, int prio, QueueType qt) {
+    if (count == 1) {
+        add(id, at, sequence[0], prio, qt);
+        return;
+    }
+    if (!hasIo())
+        enableIo();
+    int cpu = 0, io = 0;
+    for (size_t k = 0; k < count; k++)
+        (k % 2 == 0 ? cpu : io) += sequence[k];
+    pid.push_back(id);
+    arrivalTime.push_back(at);
+    burstTime.push_back(cpu);
+    priority.push_back(prio);
+    queueType.push_back(qt);
+    bursts.insert(bursts.end(), sequence, sequence + count);
+    burstStart.push_back((int)bursts.size());
+    ioTime.push_back(io);
+}
+
+long long ProcessTable::makespanBound() const {
+    long long lastArrival = 0, work = 0;
+    for (size_t i = 0; i < size(); i++) {
+        lastArrival = max(lastArrival, (long long)arrivalTime[i]);
+        work += burstTime[i];
+        if (hasIo())
+            work += ioTime[i];
+    }
+    return lastArrival + work;
+}
+
+void ProcessTable::enableIo() {
+    burstStart.reserve(size() + 1);
+    burstStart.push_back(0);
+    bursts.reserve(size());
+    ioTime.assign(size(), 0);
+    for (int burst : burstTime) {
+        bursts.push_back(burst);
+        burstStart.push_back((int)bursts.size());
+    }
+}
+
+void ProcessTable::assign(const vector<Process>& processes) {
+    clear();
+    reserve(processes.size());
+    for (const auto& p : processes) {
+        if (p.bursts.size() > 1)
+            add(p.pid, p.arrivalTime, p.bursts.data(), p.bursts.size(), p.priority, p.queueType);
+        else
+            add(p.pid, p.arrivalTime, p.burstTime, p.priority, p.queueType);
+    }
+}
+
+Process ProcessTable::toProcess(size_t i) const {
+    Process p(pid[i], arrivalTime[i], burstTime[i], priority[i], queueType[i]);
+    if (hasIo())
+        p.ioTime = ioTime[i];
+    return p;
+}
+
+void ScheduleResult::reset(const ProcessTable& table) {
+    size_t n = table.size();
+    remainingTime.assign(table.burstTime.begin(), table.burstTime.end());
+    nextBurst.clear();
+    if (table.hasIo()) {
+        nextBurst.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            remainingTime[i] = table.bursts[table.burstStart[i]];
+            nextBurst[i] = table.burstStart[i] + 1;
+        }
+    }
+    blocked.clear();
+    clockOverflow = false;
+    cpuCount = 1;
+    ioBusyTime = 0;
+    ioOverlapTime = 0;
+    ioEnd = 0;
+    completionTime.assign(n, 0);
+    turnaroundTime.assign(n, 0);
+    waitingTime.assign(n, 0);
+    startTime.assign(n, -1);
+    responseTime.assign(n, 0);
+    contextSwitches = 0;
+    lastDispatched = -1;
+    overheadTime = 0;
+}
+
+void ScheduleResult::block(const ProcessTable& table, int i, int currentTime) {
+    int io = table.bursts[nextBurst[i]];
+    remainingTime[i] = table.bursts[nextBurst[i] + 1];
+    nextBurst[i] += 2;
+
+    if (!fitsClock((long long)currentTime + io))
+        return;
+
+    // I/O bursts start in time order, so their union only grows at its end
+    int wake = currentTime + io;
+    if (wake > ioEnd) {
+        ioBusyTime += wake - (currentTime > ioEnd ? currentTime : ioEnd);
+        ioEnd = wake;
+    }
+    blocked.push_back(make_pair(wake, i));
+    push_heap(blocked.begin(), blocked.end(), greater<pair<int, int>>());
+}
+
+void ScheduleResult::writeTo(vector<Process>& processes) const {
+    for (size_t i = 0; i < processes.size(); i++) {
+        processes[i].remainingTime = remainingTime[i];
+        processes[i].completionTime = completionTime[i];
+        processes[i].turnaroundTime = turnaroundTime[i];
+        processes[i].waitingTime = waitingTime[i];
+        processes[i].startTime = startTime[i];
+        processes[i].responseTime = responseTime[i];
+    }
+}
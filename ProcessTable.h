@@ -0,0 +1,237 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <functional>
+#include <climits>
+#include <cstddef>
+#include "Process.h"
+#include "Timeline.h"
+#include "ReadyQueues.h"
+
+class RunCheckpoints;
+
+/**
+ * Structure-of-arrays workload: one contiguous array per Process field
+ *
+ * The schedulers address processes by index, so a scan over arrival times or
+ * priorities only streams the bytes it compares instead of whole Process
+ * structs. The table is read-only during a run; per-run state lives in
+ * ScheduleResult, so one table can be shared by several runs.
+ */
+struct ProcessTable {
+    // Hot fields, read on every scheduling decision
+    std::vector<int> arrivalTime;
+    std::vector<int> burstTime;
+    std::vector<int> priority;
+
+    // Cold fields, only needed for queue routing and reporting
+    std::vector<int> pid;
+    std::vector<QueueType> queueType;
+
+    // CPU/I-O burst sequences, only filled once some process does I/O (see
+    // Process::bursts). Process i alternates bursts[burstStart[i]] (CPU),
+    // bursts[burstStart[i] + 1] (I/O), ... up to burstStart[i + 1], ending
+    // with CPU; burstTime[i] is the sum of its CPU bursts.
+    std::vector<int> burstStart;   // size() + 1 offsets into bursts
+    std::vector<int> bursts;
+    std::vector<int> ioTime;       // sum of the I/O bursts of each process
+
+    ProcessTable() {}
+    explicit ProcessTable(const std::vector<Process>& processes) { assign(processes); }
+
+    size_t size() const { return arrivalTime.size(); }
+    bool empty() const { return arrivalTime.empty(); }
+    bool hasIo() const { return !burstStart.empty(); }
+
+    void clear();
+    void reserve(size_t n);
+    void resize(size_t n);
+    void add(int pid, int arrivalTime, int burstTime, int priority, QueueType queueType);
+
+    // Adds a process with a CPU/I-O burst sequence (odd count, starting with CPU)
+    void add(int pid, int arrivalTime, const int* bursts, size_t count, int priority, QueueType queueType);
+
+    // Replaces the contents with the given processes (same order)
+    void assign(const std::vector<Process>& processes);
+
+    // Rebuilds the Process at index i with its input fields only (I/O as a total, without the sequence)
+    Process toProcess(size_t i) const;
+
+    /**
+     * Latest time at which a single CPU that never idles while a process is
+     * ready finishes the table without switch costs: the last arrival plus
+     * all CPU and I/O time. The simulators keep time in an int, so a table
+     * whose bound exceeds INT_MAX cannot be scheduled.
+     */
+    long long makespanBound() const;
+
+private:
+    // Switches to burst sequences, giving every process so far its single CPU burst
+    void enableIo();
+};
+
+/**
+ * CPU time lost when the CPU moves to another process
+ *
+ * Charged before the incoming process runs, so it delays that process and
+ * everything queued behind it. Both zero (the default) makes switches free.
+ */
+struct SwitchCost {
+    int contextSwitch = 0;   // saving and restoring state on every context switch
+    int cacheWarmup = 0;     // extra refill time when a process that already ran resumes after another one
+
+    bool isFree() const { return contextSwitch == 0 && cacheWarmup == 0; }
+};
+
+// Error of a run stopped by ScheduleResult::fitsClock
+extern const char* const CLOCK_OVERFLOW_ERROR;
+
+/**
+ * Per-run scheduling state and output metrics for a ProcessTable
+ *
+ * remainingTime is updated while scheduling; the other arrays are written
+ * once, when the process finishes.
+ */
+struct ScheduleResult {
+    std::vector<int> remainingTime;
+    std::vector<int> completionTime;
+    std::vector<int> turnaroundTime;
+    std::vector<int> waitingTime;
+    std::vector<int> startTime;      // start of the first slice, -1 until the process first runs
+    std::vector<int> responseTime;   // startTime - arrival time
+
+    // Dispatches of a process other than the one that last held the CPU
+    long long contextSwitches = 0;
+    int lastDispatched = -1;
+
+    // Time spent switching (see switchCost), included in the completion times
+    long long overheadTime = 0;
+
+    // I/O state, used for tables with I/O only: index into table.bursts of
+    // each process's next I/O burst, and the blocked processes by I/O
+    // completion time (time, process), a min-heap kept with the std heap
+    // algorithms so that reset() keeps its storage
+    std::vector<int> nextBurst;
+    std::vector<std::pair<int, int>> blocked;
+
+    long long ioBusyTime = 0;      // time during which at least one process was doing I/O
+    long long ioOverlapTime = 0;   // CPU time of the processes that ran while another was doing I/O
+    int ioEnd = 0;                 // latest I/O completion so far
+
+    // CPUs the run scheduled on (set after reset() by the multi-CPU runs)
+    int cpuCount = 1;
+
+    // Set when the run stopped because simulated time would pass INT_MAX;
+    // the metrics are then incomplete (see fitsClock)
+    bool clockOverflow = false;
+
+    // Set by the caller before a run, kept by reset()
+    SwitchCost switchCost;
+
+    // Ready queues of the run, reset (not freed) by the policy that uses
+    // them: a result reused for another run of the same size does not allocate
+    ReadyQueueStorage readyQueues;
+
+    // Optional execution recording, owned by the caller; nullptr = off
+    Timeline* timeline = nullptr;
+
+    // Optional checkpoint/resume (see Checkpoint.h), owned by the caller; nullptr = off.
+    // Only the algorithms built on runPolicy (the seven menu algorithms) use it.
+    RunCheckpoints* checkpoints = nullptr;
+
+    // Sizes the arrays for the table and resets remaining time to the (first) CPU burst
+    void reset(const ProcessTable& table);
+
+    /**
+     * Records that process i gets the CPU
+     *
+     * @return Switching overhead the caller must let pass before process i
+     *         runs (0 if the CPU stays with the same process)
+     */
+    int dispatch(int i) {
+        if (lastDispatched == i)
+            return 0;
+        int overhead = 0;
+        if (lastDispatched != -1) {
+            contextSwitches++;
+            overhead = switchCost.contextSwitch;
+            if (startTime[i] >= 0)
+                overhead += switchCost.cacheWarmup;
+            overheadTime += overhead;
+        }
+        lastDispatched = i;
+        return overhead;
+    }
+
+    /**
+     * Checks that the clock can reach end (a slice end or I/O completion)
+     *
+     * @return false, with clockOverflow set, if end is past INT_MAX: the
+     *         scheduling loop must stop
+     */
+    bool fitsClock(long long end) {
+        if (end <= INT_MAX)
+            return true;
+        clockOverflow = true;
+        return false;
+    }
+
+    // Records that process i ran from start to end; an empty slice (preempted during the switch) is ignored
+    void ran(const ProcessTable& table, int i, int start, int end) {
+        if (end <= start)
+            return;
+        if (startTime[i] < 0)
+            startTime[i] = start;
+        // Every I/O burst in progress started before this slice (nothing blocks mid-slice)
+        if (ioEnd > start)
+            ioOverlapTime += (ioEnd < end ? ioEnd : end) - start;
+        if (timeline)
+            timeline->record(i, table.pid[i], start, end);
+    }
+
+    // Records the completion of process i at the given time
+    void complete(const ProcessTable& table, int i, int currentTime) {
+        completionTime[i] = currentTime;
+        turnaroundTime[i] = currentTime - table.arrivalTime[i];
+        waitingTime[i] = turnaroundTime[i] - table.burstTime[i] - (table.hasIo() ? table.ioTime[i] : 0);
+        responseTime[i] = startTime[i] - table.arrivalTime[i];
+    }
+
+    /**
+     * Records that process i used up its current CPU burst at currentTime
+     *
+     * @return true if that was its last burst (the process is complete);
+     *         false if it blocked for I/O, to be handed back by wakeUp with
+     *         its next CPU burst in remainingTime
+     */
+    bool endBurst(const ProcessTable& table, int i, int currentTime) {
+        if (table.hasIo() && nextBurst[i] < table.burstStart[i + 1]) {
+            block(table, i, currentTime);
+            return false;
+        }
+        complete(table, i, currentTime);
+        return true;
+    }
+
+    // Time the next blocked process finishes its I/O, INT_MAX if none is blocked
+    int nextWakeup() const { return blocked.empty() ? INT_MAX : blocked.front().first; }
+
+    // Calls enqueue(i) for every process whose I/O finished by currentTime, earliest first
+    template <typename Enqueue>
+    void wakeUp(int currentTime, Enqueue enqueue) {
+        while (!blocked.empty() && blocked.front().first <= currentTime) {
+            int i = blocked.front().second;
+            std::pop_heap(blocked.begin(), blocked.end(), std::greater<std::pair<int, int>>());
+            blocked.pop_back();
+            enqueue(i);
+        }
+    }
+
+    // Copies the metrics back into the matching Process vector (same order as the table)
+    void writeTo(std::vector<Process>& processes) const;
+
+private:
+    // Starts the I/O burst that follows process i's current CPU burst
+    void block(const ProcessTable& table, int i, int currentTime);
+};
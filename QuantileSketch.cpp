@@ -0,0 +1,57 @@
+#include "QuantileSketch.h"
+#include <cstring>
+#include <cmath>
+
+void QuantileSketch::clear() {
+    memset(counts, 0, sizeof(counts));
+    count = 0;
+    sum = 0;
+    maximum = 0;
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    for (int i = 0; i < BUCKET_COUNT; i++)
+        counts[i] += other.counts[i];
+    count += other.count;
+    sum += other.sum;
+    if (other.maximum > maximum)
+        maximum = other.maximum;
+}
+
+long long QuantileSketch::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS)
+        return index;
+    int shift = (index - SUB_BUCKETS) / HALF_SUB_BUCKETS + 1;
+    long long subBucket = (index - SUB_BUCKETS) % HALF_SUB_BUCKETS + HALF_SUB_BUCKETS;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+int QuantileSketch::quantile(double q) const {
+    if (count == 0)
+        return 0;
+    // Nearest rank: the ceil(q * count)-th smallest value
+    long long rank = (long long)ceil(q * (double)count);
+    if (rank < 1)
+        rank = 1;
+
+    long long seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += (long long)counts[i];
+        if (seen >= rank) {
+            long long bound = bucketUpperBound(i);
+            return bound < maximum ? (int)bound : maximum;
+        }
+    }
+    return maximum;
+}
+
+QuantileSummary summarize(const QuantileSketch& sketch) {
+    QuantileSummary s;
+    s.mean = sketch.mean();
+    s.p50 = sketch.quantile(0.50);
+    s.p90 = sketch.quantile(0.90);
+    s.p99 = sketch.quantile(0.99);
+    s.p999 = sketch.quantile(0.999);
+    s.max = sketch.max();
+    return s;
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * Fixed-memory quantile sketch for non-negative integer times
+ *
+ * HDR-histogram style log-linear buckets: values below 128 are counted
+ * exactly, larger values in buckets that keep the top 7 significant bits, so
+ * a reported quantile is at most ~1.6% above the true value (it is the upper
+ * bound of the bucket holding it, clamped to the exact maximum). Memory is
+ * about 13 KB whatever the number of values, and adding a value is a few
+ * shifts and one increment.
+ *
+ * Sketches of independent runs can be merged.
+ */
+class QuantileSketch {
+public:
+    QuantileSketch() { clear(); }
+
+    void add(int value) {
+        if (value < 0)
+            value = 0;
+        counts[bucketOf((uint32_t)value)]++;
+        count++;
+        sum += value;
+        if (value > maximum)
+            maximum = value;
+    }
+
+    void merge(const QuantileSketch& other);
+    void clear();
+
+    /**
+     * Value at quantile q (0..1), e.g. 0.99 for p99
+     *
+     * @return Upper bound of the bucket holding the q-th value, 0 if empty
+     */
+    int quantile(double q) const;
+
+    long long size() const { return count; }
+    long long total() const { return sum; }
+    int max() const { return maximum; }
+    double mean() const { return count ? (double)sum / count : 0.0; }
+
+private:
+    static const int SUB_BUCKET_BITS = 7;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;            // 128
+    static const int HALF_SUB_BUCKETS = SUB_BUCKETS / 2;            // 64
+    static const int BUCKET_COUNT = SUB_BUCKETS + 24 * HALF_SUB_BUCKETS; // up to 2^31 - 1
+
+    // Index of the highest set bit (value > 0)
+    static int highestBit(uint32_t value) {
+#if defined(__GNUC__)
+        return 31 - __builtin_clz(value);
+#elif defined(_MSC_VER)
+        unsigned long bit;
+        _BitScanReverse(&bit, value);
+        return (int)bit;
+#else
+        int bit = 0;
+        while (value >>= 1)
+            bit++;
+        return bit;
+#endif
+    }
+
+    static int bucketOf(uint32_t value) {
+        if (value < (uint32_t)SUB_BUCKETS)
+            return (int)value;
+        int shift = highestBit(value) - (SUB_BUCKET_BITS - 1);
+        return SUB_BUCKETS + (shift - 1) * HALF_SUB_BUCKETS + (int)(value >> shift) - HALF_SUB_BUCKETS;
+    }
+
+    // Largest value that falls into bucket index
+    static long long bucketUpperBound(int index);
+
+    uint64_t counts[BUCKET_COUNT];
+    long long count;
+    long long sum;
+    int maximum;
+};
+
+// The tail summary reported for each metric
+struct QuantileSummary {
+    double mean = 0.0;
+    int p50 = 0;
+    int p90 = 0;
+    int p99 = 0;
+    int p999 = 0;
+    int max = 0;
+};
+
+QuantileSummary summarize(const QuantileSketch& sketch);
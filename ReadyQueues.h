@@ -0,0 +1,254 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*
+ * Ready-queue containers of the table-based schedulers
+ *
+ * They hold table indices in flat arrays that keep their capacity when they
+ * are reset, so a ScheduleResult reused for another run schedules without
+ * allocating once its storage has grown to the workload.
+ */
+
+/**
+ * Heap entry: a process index with its sort key copied next to it
+ *
+ * The key is taken from the table and the result when the process is pushed
+ * (a queued process's key does not change), so sifts compare the entries
+ * themselves instead of gathering fields from several arrays per comparison.
+ * Smaller (key, tie) pops first.
+ */
+struct HeapEntry {
+    uint64_t key;
+    uint64_t tie;
+    int index;
+};
+
+// Two signed ints as one unsigned key that orders like (high, low)
+inline uint64_t packKey(int high, int low) {
+    return ((uint64_t)((uint32_t)high ^ 0x80000000u) << 32) | ((uint32_t)low ^ 0x80000000u);
+}
+
+/**
+ * Binary min-heap of HeapEntry
+ *
+ * Uses the std heap algorithms like std::priority_queue, so entries with
+ * equal keys come out in the same order as they would from a
+ * priority_queue<int> with the equivalent comparator.
+ */
+class KeyedHeap {
+public:
+    // Empties the heap, keeping its storage
+    void clear() { entries.clear(); }
+
+    bool empty() const { return entries.empty(); }
+    size_t size() const { return entries.size(); }
+
+    void push(const HeapEntry& entry) {
+        entries.push_back(entry);
+        std::push_heap(entries.begin(), entries.end(), after);
+    }
+
+    // Removes and returns the index of the smallest entry (the heap must not be empty)
+    int pop() {
+        int i = entries.front().index;
+        std::pop_heap(entries.begin(), entries.end(), after);
+        entries.pop_back();
+        return i;
+    }
+
+    // Entries in heap order, for checkpoints; assign() takes them back as they were
+    const std::vector<HeapEntry>& contents() const { return entries; }
+    void assign(const std::vector<HeapEntry>& heapOrder) { entries.assign(heapOrder.begin(), heapOrder.end()); }
+
+private:
+    std::vector<HeapEntry> entries;
+
+    static bool after(const HeapEntry& a, const HeapEntry& b) {
+        return a.key != b.key ? a.key > b.key : a.tie > b.tie;
+    }
+};
+
+/**
+ * FIFO of table indices in a circular buffer
+ *
+ * A process is in at most one ready queue at a time, so a buffer with one
+ * slot per process never overflows.
+ */
+class IndexRing {
+public:
+    // Empties the queue and makes room for capacity processes, keeping the storage if it is large enough
+    void reset(size_t capacity) {
+        if (slots.size() < capacity)
+            slots.resize(capacity);
+        head = 0;
+        count = 0;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    // k-th process from the front
+    int operator[](size_t k) const { return slots[wrap(head + k)]; }
+    int front() const { return slots[head]; }
+    int back() const { return slots[wrap(head + count - 1)]; }
+
+    void push_back(int i) {
+        slots[wrap(head + count)] = i;
+        count++;
+    }
+
+    int pop_front() {
+        int i = slots[head];
+        head = wrap(head + 1);
+        count--;
+        return i;
+    }
+
+private:
+    std::vector<int> slots;
+    size_t head = 0;
+    size_t count = 0;
+
+    size_t wrap(size_t k) const { return k < slots.size() ? k : k - slots.size(); }
+};
+
+// Levels a LevelBitmap can hold (64 words of 64 bits under one summary word)
+const int MAX_BITMAP_LEVELS = 4096;
+
+/**
+ * Bitmap of the non-empty levels of a multi-level structure (MLFQ levels,
+ * priority buckets)
+ * One bit per level plus a summary word with one bit per 64-level word, so
+ * the highest-priority (lowest-numbered) non-empty level is found with two
+ * find-first-set instructions for up to MAX_BITMAP_LEVELS levels.
+ */
+class LevelBitmap {
+public:
+    LevelBitmap() {}
+    explicit LevelBitmap(int levels) : words((levels + 63) / 64, 0) {}
+
+    // Clears every level and sizes the bitmap for levels levels, keeping its storage
+    void reset(int levels) {
+        words.assign((levels + 63) / 64, 0);
+        summary = 0;
+    }
+
+    bool empty() const { return summary == 0; }
+
+    void set(int level) {
+        words[level >> 6] |= 1ull << (level & 63);
+        summary |= 1ull << (level >> 6);
+    }
+
+    void clear(int level) {
+        uint64_t& word = words[level >> 6];
+        word &= ~(1ull << (level & 63));
+        if (word == 0)
+            summary &= ~(1ull << (level >> 6));
+    }
+
+    // Lowest set level; the bitmap must not be empty
+    int first() const {
+        int word = lowestBit(summary);
+        return (word << 6) + lowestBit(words[word]);
+    }
+
+private:
+    static int lowestBit(uint64_t value) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(value);
+#elif defined(_MSC_VER)
+        unsigned long bit;
+        _BitScanForward64(&bit, value);
+        return (int)bit;
+#else
+        int bit = 0;
+        while (!(value & 1)) {
+            value >>= 1;
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    uint64_t summary = 0;
+    std::vector<uint64_t> words;
+};
+
+/**
+ * FIFO queues of table indices, one per bucket, under a LevelBitmap
+ *
+ * The buckets are intrusive linked lists (a next link per process), so push
+ * and pop of the first process of the lowest non-empty bucket are O(1)
+ * whatever the number of queued processes.
+ */
+class BucketQueue {
+public:
+    // Empties the queue for buckets [0, buckets) and processes [0, n), keeping the storage
+    void reset(int buckets, size_t n) {
+        head.assign(buckets, -1);
+        tail.resize(buckets);
+        if (next.size() < n)
+            next.resize(n);
+        bitmap.reset(buckets);
+    }
+
+    bool empty() const { return bitmap.empty(); }
+
+    void push(int bucket, int i) {
+        next[i] = -1;
+        if (head[bucket] < 0) {
+            head[bucket] = i;
+            bitmap.set(bucket);
+        }
+        else {
+            next[tail[bucket]] = i;
+        }
+        tail[bucket] = i;
+    }
+
+    // Removes and returns the front of the lowest non-empty bucket (the queue must not be empty)
+    int pop() {
+        int bucket = bitmap.first();
+        int i = head[bucket];
+        head[bucket] = next[i];
+        if (head[bucket] < 0)
+            bitmap.clear(bucket);
+        return i;
+    }
+
+    int bucketCount() const { return (int)head.size(); }
+
+    // Calls visit(bucket, i) for every queued process, bucket by bucket, each in FIFO order
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (int bucket = 0; bucket < (int)head.size(); bucket++) {
+            for (int i = head[bucket]; i >= 0; i = next[i])
+                visit(bucket, i);
+        }
+    }
+
+private:
+    std::vector<int> head, tail;
+    std::vector<int> next;
+    LevelBitmap bitmap;
+};
+
+/**
+ * Ready-queue storage of one run, borrowed by the scheduling policy
+ * (FCFS and Round Robin use fifo; the heap algorithms use heap; the
+ * Multi-Level Queue uses fifo for SYSTEM, heap or buckets for INTERACTIVE
+ * and secondFifo for BATCH; Priority Non-Preemptive uses heap or buckets)
+ */
+struct ReadyQueueStorage {
+    IndexRing fifo;
+    IndexRing secondFifo;
+    KeyedHeap heap;
+    BucketQueue buckets;
+};
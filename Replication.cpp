@@ -0,0 +1,181 @@
+#include "Replication.h"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <climits>
+
+using namespace std;
+
+// Most replications of one run
+static const int MAX_REPLICATIONS = 1000000;
+
+// Two-sided 95% Student's t quantiles for 1..30 degrees of freedom
+static const double T_975[30] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+/**
+ * 97.5% quantile of Student's t distribution
+ * Table up to 30 degrees of freedom, then the Cornish-Fisher expansion
+ * around the normal quantile (error below 0.001).
+ */
+static double tQuantile(int degrees) {
+    if (degrees <= 30)
+        return T_975[degrees - 1];
+    const double z = 1.959964;
+    double z3 = z * z * z, z5 = z3 * z * z;
+    return z + (z3 + z) / (4.0 * degrees) + (5 * z5 + 16 * z3 + 3 * z) / (96.0 * degrees * degrees);
+}
+
+// Per-process averages of one replication
+struct ReplicationSample {
+    double waiting = 0.0;
+    double turnaround = 0.0;
+    double response = 0.0;
+    string error;   // generation failed
+};
+
+// Running mean and variance of one metric over the replications (Welford)
+struct RunningStats {
+    long long count = 0;
+    double mean = 0.0;
+    double squares = 0.0;   // sum of squared differences from the mean
+
+    void add(double value) {
+        count++;
+        double delta = value - mean;
+        mean += delta / count;
+        squares += delta * (value - mean);
+    }
+
+    MetricInterval interval() const {
+        MetricInterval result;
+        result.mean = mean;
+        if (count > 1) {
+            result.stddev = sqrt(squares / (count - 1));
+            result.halfWidth = tQuantile((int)min<long long>(count - 1, INT_MAX)) * result.stddev / sqrt((double)count);
+        }
+        return result;
+    }
+};
+
+// Whether the interval is at most widthPercent % of the mean wide
+static bool narrowEnough(const MetricInterval& interval, double widthPercent) {
+    return 2.0 * interval.halfWidth <= widthPercent / 100.0 * fabs(interval.mean);
+}
+
+bool validateReplicationOptions(const ReplicationOptions& options, string& error) {
+    if (options.maxReplications < 2 || options.maxReplications > MAX_REPLICATIONS)
+        error = "replications must be between 2 and " + to_string(MAX_REPLICATIONS);
+    else if (options.minReplications < 2 || options.minReplications > options.maxReplications)
+        error = "minimum replications must be between 2 and the number of replications";
+    else if (!(options.ciWidth >= 0.0))
+        error = "confidence interval width must not be negative";
+    else
+        return validateGeneratorOptions(options.generator, error);
+    return false;
+}
+
+bool runReplications(const ReplicationOptions& options, const ScheduleFunction& schedule, ThreadPool& pool,
+    ReplicationReport& report, string& error)
+{
+    // Seeds are drawn upfront, so replication r has the same workload in every run
+    int k = options.maxReplications;
+    vector<uint64_t> seeds(k);
+    SplitMix64 seedStream = { options.generator.seed };
+    for (int r = 0; r < k; r++)
+        seeds[r] = seedStream.next();
+
+    vector<ReplicationSample> samples(k);
+    RunningStats waiting, turnaround, response;
+    int done = 0;
+    int wave = (int)max(1u, pool.size());
+    report.processCount = options.generator.count;
+    report.converged = false;
+
+    while (done < k && !report.converged) {
+        int end = min(k, done + wave);
+        for (int r = done; r < end; r++) {
+            ReplicationSample* slot = &samples[r];
+            GeneratorOptions generator = options.generator;
+            generator.seed = seeds[r];
+            SwitchCost switchCost = options.switchCost;
+            pool.submit([generator, switchCost, &schedule, slot]() {
+                ProcessTable table;
+                if (!generateWorkload(generator, table, slot->error))
+                    return;
+                ScheduleResult result;
+                result.switchCost = switchCost;
+                schedule(table, result);
+                if (result.clockOverflow) {
+                    slot->error = CLOCK_OVERFLOW_ERROR;
+                    return;
+                }
+
+                long long totalWaiting = 0, totalTurnaround = 0, totalResponse = 0;
+                size_t n = table.size();
+                for (size_t i = 0; i < n; i++) {
+                    totalWaiting += result.waitingTime[i];
+                    totalTurnaround += result.turnaroundTime[i];
+                    totalResponse += result.responseTime[i];
+                }
+                slot->waiting = (double)totalWaiting / n;
+                slot->turnaround = (double)totalTurnaround / n;
+                slot->response = (double)totalResponse / n;
+            });
+        }
+        pool.wait();
+
+        // Stopping rule, one replication at a time in seed order
+        for (; done < end && !report.converged; done++) {
+            const ReplicationSample& sample = samples[done];
+            if (!sample.error.empty()) {
+                error = sample.error;
+                return false;
+            }
+            waiting.add(sample.waiting);
+            turnaround.add(sample.turnaround);
+            response.add(sample.response);
+            report.converged = options.ciWidth > 0.0 && done + 1 >= options.minReplications
+                && narrowEnough(waiting.interval(), options.ciWidth)
+                && narrowEnough(turnaround.interval(), options.ciWidth)
+                && narrowEnough(response.interval(), options.ciWidth);
+        }
+    }
+
+    report.replications = done;
+    report.waiting = waiting.interval();
+    report.turnaround = turnaround.interval();
+    report.response = response.interval();
+    return true;
+}
+
+void printReplicationReport(const ReplicationReport& report, FILE* out) {
+    fprintf(out, "\n  %s: %d replications of %zu processes%s\n\n", report.title.c_str(), report.replications,
+        report.processCount, report.converged ? " (target interval width reached)" : "");
+    fprintf(out, "  %-12s %12s %12s %12s %12s %12s\n", "Metric", "Mean", "Std Dev", "95% CI Low", "95% CI High", "+/- %");
+    fprintf(out, "  %s\n", string(12 + 13 * 5, '-').c_str());
+    const char* names[3] = { "Waiting", "Turnaround", "Response" };
+    const MetricInterval* intervals[3] = { &report.waiting, &report.turnaround, &report.response };
+    for (int m = 0; m < 3; m++) {
+        const MetricInterval& i = *intervals[m];
+        fprintf(out, "  %-12s %12.2f %12.2f %12.2f %12.2f %12.2f\n", names[m], i.mean, i.stddev, i.low(), i.high(),
+            i.mean != 0.0 ? 100.0 * i.halfWidth / fabs(i.mean) : 0.0);
+    }
+    fprintf(out, "\n");
+    fflush(out);
+}
+
+void writeReplicationCsv(const ReplicationReport& report, FILE* out) {
+    fputs("algorithm,processes,replications,converged,metric,mean,stddev,ci95_low,ci95_high\n", out);
+    const char* names[3] = { "waiting", "turnaround", "response" };
+    const MetricInterval* intervals[3] = { &report.waiting, &report.turnaround, &report.response };
+    for (int m = 0; m < 3; m++) {
+        const MetricInterval& i = *intervals[m];
+        fprintf(out, "\"%s\",%zu,%d,%d,%s,%.4f,%.4f,%.4f,%.4f\n", report.title.c_str(), report.processCount,
+            report.replications, report.converged ? 1 : 0, names[m], i.mean, i.stddev, i.low(), i.high());
+    }
+    fflush(out);
+}
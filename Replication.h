@@ -0,0 +1,85 @@
+#pragma once
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <functional>
+#include "ProcessTable.h"
+#include "ThreadPool.h"
+#include "WorkloadGenerator.h"
+
+/**
+ * Parameters of a Monte Carlo replication run
+ *
+ * Replication r schedules a workload generated with generator and the r-th
+ * seed of a SplitMix64 stream started at generator.seed. The seeds do not
+ * depend on the algorithm, so replication runs of two algorithms with the
+ * same options see the same workloads (paired samples).
+ */
+struct ReplicationOptions {
+    GeneratorOptions generator;
+    int maxReplications = 30;
+    int minReplications = 5;     // replications before the stopping rule is checked
+    double ciWidth = 0.0;        // stop once every 95% interval is at most this % of its mean wide (0 = never)
+    SwitchCost switchCost;
+};
+
+// Scheduling run of one replication, e.g. a lambda calling runAlgorithm
+typedef std::function<void(const ProcessTable&, ScheduleResult&)> ScheduleFunction;
+
+// Mean of a per-replication average with its 95% confidence interval (Student's t)
+struct MetricInterval {
+    double mean = 0.0;
+    double stddev = 0.0;       // sample standard deviation over the replications
+    double halfWidth = 0.0;    // the interval is mean ± halfWidth
+
+    double low() const { return mean - halfWidth; }
+    double high() const { return mean + halfWidth; }
+};
+
+// Outcome of a replication run
+struct ReplicationReport {
+    std::string title;
+    size_t processCount = 0;   // per replication
+    int replications = 0;      // replications the intervals are based on
+    bool converged = false;    // stopped by the ciWidth rule
+    MetricInterval waiting;
+    MetricInterval turnaround;
+    MetricInterval response;
+};
+
+/**
+ * Checks the replication counts, the interval width and the generator options
+ *
+ * @return false (with error set) on a bad parameter
+ */
+bool validateReplicationOptions(const ReplicationOptions& options, std::string& error);
+
+/**
+ * Runs one algorithm over independently seeded workloads in parallel
+ *
+ * Every pool task generates, schedules and reduces one whole replication on
+ * its own table and result, and only writes its own slot of the sample, so
+ * the tasks share nothing mutable. Replications run in waves of one per pool
+ * thread; after each wave the stopping rule is applied to the replications in
+ * seed order, and the report covers the shortest prefix (of at least
+ * minReplications) whose intervals are all narrow enough, so the outcome does
+ * not depend on the thread count.
+ *
+ * Time Complexity: O(k × s) where k is the number of replications run and s
+ *                  the cost of generating and scheduling one workload
+ *
+ * @param options Validated run parameters
+ * @param schedule Algorithm to run; called concurrently, so it must not modify shared state
+ * @param pool Pool running one replication per task
+ * @param report Receives the intervals (report.title is left to the caller)
+ * @param error Receives a description of the problem on failure
+ * @return false if a workload could not be generated
+ */
+bool runReplications(const ReplicationOptions& options, const ScheduleFunction& schedule, ThreadPool& pool,
+    ReplicationReport& report, std::string& error);
+
+// Writes the intervals as an aligned text table
+void printReplicationReport(const ReplicationReport& report, FILE* out);
+
+// Writes the intervals as CSV, one row per metric
+void writeReplicationCsv(const ReplicationReport& report, FILE* out);
@@ -0,0 +1,452 @@
+#include "ResultSink.h"
+#include <algorithm>
+
+using namespace std;
+
+static const size_t FLUSH_SIZE = 1 << 20;
+
+/**
+ * Appends a signed integer to the output buffer
+ * Avoids the per-call overhead of iostream formatting for large result sets
+ */
+static void appendInt(string& out, long long value) {
+    char digits[24];
+    int len = 0;
+    unsigned long long magnitude = value < 0 ? 0ull - (unsigned long long)value : (unsigned long long)value;
+    do {
+        digits[len++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+    if (value < 0)
+        out += '-';
+    while (len)
+        out += digits[--len];
+}
+
+// Appends an integer left-aligned in a field of the given width
+static void appendPadded(string& out, long long value, size_t width) {
+    size_t start = out.size();
+    appendInt(out, value);
+    size_t written = out.size() - start;
+    if (written < width)
+        out.append(width - written, ' ');
+}
+
+// Appends a number with two decimals
+static void appendFixed(string& out, double value) {
+    char text[64];
+    snprintf(text, sizeof(text), "%.2f", value);
+    out += text;
+}
+
+// Appends a JSON string literal
+static void appendJsonString(string& out, const string& value) {
+    out += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    out += '"';
+}
+
+void ResultTotals::add(const Process& p) {
+    count++;
+    turnaroundTime.add(p.turnaroundTime);
+    waitingTime.add(p.waitingTime);
+    responseTime.add(p.responseTime);
+    double slowdown = p.burstTime > 0 ? (double)p.turnaroundTime / p.burstTime : 1.0;
+    totalSlowdown += slowdown;
+    totalSquaredSlowdown += slowdown * slowdown;
+    maxSlowdown = max(maxSlowdown, slowdown);
+    makespan = max(makespan, p.completionTime);
+    cpuTime += p.burstTime;
+}
+
+void ResultTotals::addSwitches(long long count, long long overheadTime) {
+    switchesCounted = true;
+    contextSwitches += count;
+    switchOverhead += overheadTime;
+}
+
+void ResultTotals::addIo(long long busyTime, long long overlapTime) {
+    ioCounted = true;
+    ioBusyTime += busyTime;
+    ioOverlapTime += overlapTime;
+}
+
+BufferedResultSink::BufferedResultSink(FILE* out) : out(out) {
+    buffer.reserve(FLUSH_SIZE + 1024);
+}
+
+BufferedResultSink::~BufferedResultSink() {
+    flush();
+}
+
+void BufferedResultSink::flushIfFull() {
+    if (buffer.size() >= FLUSH_SIZE)
+        flush();
+}
+
+void BufferedResultSink::flush() {
+    if (!buffer.empty() && fwrite(buffer.data(), 1, buffer.size(), out) != buffer.size())
+        writeFailed = true;
+    buffer.clear();
+}
+
+void BufferedResultSink::finish() {
+    flush();
+    if (fflush(out) != 0)
+        writeFailed = true;
+}
+
+/* ================= TABLE ================= */
+
+// ANSI Color Codes
+static const char* RESET = "\033[0m";
+static const char* RED = "\033[31m";
+static const char* GREEN = "\033[32m";
+static const char* YELLOW = "\033[33m";
+static const char* MAGENTA = "\033[35m";
+static const char* CYAN = "\033[36m";
+static const char* WHITE = "\033[37m";
+static const char* BOLD = "\033[1m";
+
+// Box Drawing Characters (UTF-8)
+static const char* HL = "\u2550"; // Horizontal Line ═
+static const char* VL = "\u2551"; // Vertical Line ║
+static const char* TL = "\u2554"; // Top Left ╔
+static const char* TR = "\u2557"; // Top Right ╗
+static const char* BL = "\u255A"; // Bottom Left ╚
+static const char* BR = "\u255D"; // Bottom Right ╝
+static const char* T_DOWN = "\u2566"; // ╦
+static const char* T_UP = "\u2569";   // ╩
+static const char* T_CROSS = "\u256C";// ╬
+static const char* T_LEFT = "\u2560"; // ╠
+static const char* T_RIGHT = "\u2563";// ╣
+
+// Column widths: PID, Arr, Brst, Comp, TAT, Wait, Resp, Visual bar
+static const int COLUMN_WIDTHS[] = { 6, 8, 8, 8, 8, 8, 8, 20 };
+static const int COLUMN_COUNT = 8;
+static const int BAR_CHARS = 18; // visible characters of the Wait|Burst bar
+
+// Appends one "label p50 p90 p99 p99.9 max" line of the percentile block
+static void appendPercentileRow(string& out, const char* label, const QuantileSketch& sketch) {
+    QuantileSummary s = summarize(sketch);
+    char row[128];
+    snprintf(row, sizeof(row), "%s%8d %8d %8d %8d %8d\n", label, s.p50, s.p90, s.p99, s.p999, s.max);
+    out += row;
+}
+
+/**
+ * Builds a horizontal separator once per table
+ * The multi-byte line character is repeated into a single string instead of
+ * being written one character at a time.
+ */
+static string horizontalLine(const char* left, const char* mid, const char* right) {
+    string line = left;
+    for (int c = 0; c < COLUMN_COUNT; c++) {
+        if (c > 0)
+            line += mid;
+        for (int i = 0; i < COLUMN_WIDTHS[c]; i++)
+            line += HL;
+    }
+    line += right;
+    line += '\n';
+    return line;
+}
+
+void TableResultSink::begin(const string& title) {
+    totals = ResultTotals();
+
+    buffer += "\n";
+    buffer += BOLD; buffer += MAGENTA;
+    buffer += "  " + title + " Algorithm Results";
+    buffer += RESET; buffer += "\n";
+
+    // Top Border
+    buffer += CYAN;
+    buffer += horizontalLine(TL, T_DOWN, TR);
+
+    // Header
+    static const char* HEADERS[] = { "PID", "Arr", "Brst", "Comp", "TAT", "Wait", "Resp", "Visual (Wait|Burst)" };
+    buffer += VL;
+    for (int c = 0; c < COLUMN_COUNT; c++) {
+        string cell = string(" ") + HEADERS[c];
+        cell.resize(COLUMN_WIDTHS[c], ' ');
+        buffer += WHITE; buffer += cell; buffer += CYAN; buffer += VL;
+    }
+    buffer += "\n";
+
+    // Separator
+    buffer += horizontalLine(T_LEFT, T_CROSS, T_RIGHT);
+}
+
+void TableResultSink::add(const Process& p) {
+    totals.add(p);
+
+    const long long values[] = { p.pid, p.arrivalTime, p.burstTime, p.completionTime, p.turnaroundTime, p.waitingTime, p.responseTime };
+    buffer += VL;
+    for (int c = 0; c < COLUMN_COUNT - 1; c++) {
+        buffer += (c == 0) ? YELLOW : RESET;
+        buffer += ' ';
+        appendPadded(buffer, values[c], COLUMN_WIDTHS[c] - 1);
+        buffer += CYAN; buffer += VL;
+    }
+
+    // Visual bar: (Wait + Burst) scaled to BAR_CHARS characters
+    buffer += ' ';
+    long long totalUnits = (long long)p.waitingTime + p.burstTime;
+    int visibleBarLength = 0;
+    if (totalUnits > 0) {
+        int waitChars = (int)((long long)p.waitingTime * BAR_CHARS / totalUnits);
+        int burstChars = BAR_CHARS - waitChars;
+        // Wait part (Red)
+        if (waitChars > 0) { buffer += RED; buffer.append(waitChars, '.'); buffer += RESET; }
+        // Burst part (Green)
+        if (burstChars > 0) { buffer += GREEN; buffer.append(burstChars, '#'); buffer += RESET; }
+        visibleBarLength = BAR_CHARS;
+    }
+    buffer.append(COLUMN_WIDTHS[COLUMN_COUNT - 1] - 1 - visibleBarLength, ' ');
+    buffer += CYAN; buffer += VL; buffer += "\n";
+
+    flushIfFull();
+}
+
+void TableResultSink::switches(long long count, long long overheadTime) {
+    totals.addSwitches(count, overheadTime);
+}
+
+void TableResultSink::ioActivity(long long busyTime, long long overlapTime) {
+    totals.addIo(busyTime, overlapTime);
+}
+
+void TableResultSink::end() {
+    // Bottom Border
+    buffer += horizontalLine(BL, T_UP, BR);
+    buffer += RESET;
+
+    // Averages
+    buffer += "\n";
+    buffer += YELLOW; buffer += "  Average Turnaround Time: "; buffer += BOLD; buffer += WHITE;
+    appendFixed(buffer, totals.averageTurnaroundTime());
+    buffer += RESET; buffer += "\n";
+    buffer += YELLOW; buffer += "  Average Waiting Time:    "; buffer += BOLD; buffer += WHITE;
+    appendFixed(buffer, totals.averageWaitingTime());
+    buffer += RESET; buffer += "\n";
+    buffer += YELLOW; buffer += "  Average Response Time:   "; buffer += BOLD; buffer += WHITE;
+    appendFixed(buffer, totals.averageResponseTime());
+    buffer += RESET; buffer += "\n";
+    buffer += YELLOW; buffer += "  Slowdown (TAT / Burst):  "; buffer += BOLD; buffer += WHITE;
+    appendFixed(buffer, totals.averageSlowdown());
+    buffer += " avg, "; appendFixed(buffer, totals.maxSlowdown); buffer += " max";
+    buffer += RESET; buffer += "\n";
+    buffer += YELLOW; buffer += "  Fairness (Jain, 0-1):    "; buffer += BOLD; buffer += WHITE;
+    appendFixed(buffer, totals.fairnessIndex());
+    buffer += RESET; buffer += "\n";
+    if (totals.switchesCounted) {
+        buffer += YELLOW; buffer += "  Context Switches:        "; buffer += BOLD; buffer += WHITE;
+        appendInt(buffer, totals.contextSwitches);
+        buffer += RESET; buffer += YELLOW; buffer += ", overhead "; buffer += BOLD; buffer += WHITE;
+        appendInt(buffer, totals.switchOverhead);
+        buffer += RESET; buffer += YELLOW; buffer += " ("; buffer += BOLD; buffer += WHITE;
+        appendFixed(buffer, totals.makespan > 0 ? 100.0 * totals.switchOverhead / totals.makespan : 0.0);
+        buffer += RESET; buffer += YELLOW; buffer += "% of the makespan)"; buffer += RESET; buffer += "\n";
+    }
+    buffer += YELLOW; buffer += "  CPU Utilization:         "; buffer += BOLD; buffer += WHITE;
+    appendFixed(buffer, totals.cpuUtilization());
+    buffer += "%";
+    if (totals.cpuCount > 1) {
+        buffer += RESET; buffer += YELLOW; buffer += " (average of "; buffer += BOLD; buffer += WHITE;
+        appendInt(buffer, totals.cpuCount);
+        buffer += RESET; buffer += YELLOW; buffer += " CPUs)";
+    }
+    buffer += RESET; buffer += "\n";
+    if (totals.ioCounted) {
+        buffer += YELLOW; buffer += "  I/O Busy Time:           "; buffer += BOLD; buffer += WHITE;
+        appendInt(buffer, totals.ioBusyTime);
+        buffer += RESET; buffer += YELLOW; buffer += ", overlapped with the CPU "; buffer += BOLD; buffer += WHITE;
+        appendFixed(buffer, totals.ioOverlap());
+        buffer += "%"; buffer += RESET; buffer += "\n";
+    }
+    buffer += "\n";
+
+    // Tail percentiles
+    buffer += YELLOW; buffer += "  Percentiles      p50      p90      p99    p99.9      max"; buffer += RESET; buffer += "\n";
+    appendPercentileRow(buffer, "  Turnaround ", totals.turnaroundTime);
+    appendPercentileRow(buffer, "  Waiting    ", totals.waitingTime);
+    appendPercentileRow(buffer, "  Response   ", totals.responseTime);
+    buffer += "\n";
+
+    finish();
+}
+
+/* ================= CSV ================= */
+
+void CsvResultSink::begin(const string& title) {
+    quotedTitle = "\"" + title + "\"";
+    buffer += "algorithm,pid,arrival,burst,priority,queue,completion,turnaround,waiting,response\n";
+}
+
+void CsvResultSink::add(const Process& p) {
+    buffer += quotedTitle;
+    buffer += ','; appendInt(buffer, p.pid);
+    buffer += ','; appendInt(buffer, p.arrivalTime);
+    buffer += ','; appendInt(buffer, p.burstTime);
+    buffer += ','; appendInt(buffer, p.priority);
+    buffer += ','; appendInt(buffer, p.queueType);
+    buffer += ','; appendInt(buffer, p.completionTime);
+    buffer += ','; appendInt(buffer, p.turnaroundTime);
+    buffer += ','; appendInt(buffer, p.waitingTime);
+    buffer += ','; appendInt(buffer, p.responseTime);
+    buffer += '\n';
+    flushIfFull();
+}
+
+void CsvResultSink::end() {
+    finish();
+}
+
+/* ================= JSON ================= */
+
+// Appends ,"<metric>":{"avg":..,"p50":..,"p90":..,"p99":..,"p999":..,"max":..}
+static void appendJsonSummary(string& out, const char* metric, const QuantileSketch& sketch) {
+    QuantileSummary s = summarize(sketch);
+    out += ",\""; out += metric; out += "\":{\"avg\":"; appendFixed(out, s.mean);
+    out += ",\"p50\":"; appendInt(out, s.p50);
+    out += ",\"p90\":"; appendInt(out, s.p90);
+    out += ",\"p99\":"; appendInt(out, s.p99);
+    out += ",\"p999\":"; appendInt(out, s.p999);
+    out += ",\"max\":"; appendInt(out, s.max);
+    out += '}';
+}
+
+void JsonResultSink::begin(const string& title) {
+    totals = ResultTotals();
+    buffer += "{\"algorithm\":";
+    appendJsonString(buffer, title);
+    buffer += ",\"processes\":[";
+}
+
+void JsonResultSink::add(const Process& p) {
+    buffer += (totals.count == 0) ? "\n" : ",\n";
+    totals.add(p);
+    buffer += "{\"pid\":"; appendInt(buffer, p.pid);
+    buffer += ",\"arrival\":"; appendInt(buffer, p.arrivalTime);
+    buffer += ",\"burst\":"; appendInt(buffer, p.burstTime);
+    buffer += ",\"priority\":"; appendInt(buffer, p.priority);
+    buffer += ",\"queue\":"; appendInt(buffer, p.queueType);
+    buffer += ",\"completion\":"; appendInt(buffer, p.completionTime);
+    buffer += ",\"turnaround\":"; appendInt(buffer, p.turnaroundTime);
+    buffer += ",\"waiting\":"; appendInt(buffer, p.waitingTime);
+    buffer += ",\"response\":"; appendInt(buffer, p.responseTime);
+    buffer += '}';
+    flushIfFull();
+}
+
+void JsonResultSink::switches(long long count, long long overheadTime) {
+    totals.addSwitches(count, overheadTime);
+}
+
+void JsonResultSink::ioActivity(long long busyTime, long long overlapTime) {
+    totals.addIo(busyTime, overlapTime);
+}
+
+void JsonResultSink::end() {
+    buffer += "\n],\"summary\":{\"processes\":"; appendInt(buffer, totals.count);
+    appendJsonSummary(buffer, "turnaround", totals.turnaroundTime);
+    appendJsonSummary(buffer, "waiting", totals.waitingTime);
+    appendJsonSummary(buffer, "response", totals.responseTime);
+    buffer += ",\"slowdown\":{\"avg\":"; appendFixed(buffer, totals.averageSlowdown());
+    buffer += ",\"max\":"; appendFixed(buffer, totals.maxSlowdown);
+    buffer += "},\"jain_fairness\":"; appendFixed(buffer, totals.fairnessIndex());
+    if (totals.switchesCounted) {
+        buffer += ",\"context_switches\":"; appendInt(buffer, totals.contextSwitches);
+        buffer += ",\"switch_overhead\":"; appendInt(buffer, totals.switchOverhead);
+    }
+    buffer += ",\"cpu_utilization_pct\":"; appendFixed(buffer, totals.cpuUtilization());
+    if (totals.ioCounted) {
+        buffer += ",\"io_busy_time\":"; appendInt(buffer, totals.ioBusyTime);
+        buffer += ",\"io_overlap_pct\":"; appendFixed(buffer, totals.ioOverlap());
+    }
+    buffer += ",\"makespan\":"; appendInt(buffer, totals.makespan);
+    buffer += "}}\n";
+    finish();
+}
+
+/* ================= SUMMARY ================= */
+
+void SummaryResultSink::begin(const string& runTitle) {
+    title = runTitle;
+    totals = ResultTotals();
+}
+
+void SummaryResultSink::switches(long long count, long long overheadTime) {
+    totals.addSwitches(count, overheadTime);
+}
+
+void SummaryResultSink::ioActivity(long long busyTime, long long overlapTime) {
+    totals.addIo(busyTime, overlapTime);
+}
+
+void SummaryResultSink::end() {
+    buffer += "algorithm,processes";
+    for (const char* metric : { "turnaround", "waiting", "response" }) {
+        for (const char* column : { "avg_", "p50_", "p90_", "p99_", "p999_", "max_" }) {
+            buffer += ',';
+            buffer += column;
+            buffer += metric;
+        }
+    }
+    buffer += ",avg_slowdown,max_slowdown,jain_fairness,context_switches,switch_overhead"
+        ",cpu_utilization_pct,io_busy_time,io_overlap_pct,makespan\n";
+    buffer += "\"" + title + "\"";
+    buffer += ','; appendInt(buffer, totals.count);
+    for (const QuantileSketch* sketch : { &totals.turnaroundTime, &totals.waitingTime, &totals.responseTime }) {
+        QuantileSummary s = summarize(*sketch);
+        buffer += ','; appendFixed(buffer, s.mean);
+        buffer += ','; appendInt(buffer, s.p50);
+        buffer += ','; appendInt(buffer, s.p90);
+        buffer += ','; appendInt(buffer, s.p99);
+        buffer += ','; appendInt(buffer, s.p999);
+        buffer += ','; appendInt(buffer, s.max);
+    }
+    buffer += ','; appendFixed(buffer, totals.averageSlowdown());
+    buffer += ','; appendFixed(buffer, totals.maxSlowdown);
+    buffer += ','; appendFixed(buffer, totals.fairnessIndex());
+    buffer += ','; appendInt(buffer, totals.contextSwitches);
+    buffer += ','; appendInt(buffer, totals.switchOverhead);
+    buffer += ','; appendFixed(buffer, totals.cpuUtilization());
+    buffer += ','; appendInt(buffer, totals.ioBusyTime);
+    buffer += ','; appendFixed(buffer, totals.ioOverlap());
+    buffer += ','; appendInt(buffer, totals.makespan);
+    buffer += '\n';
+    finish();
+}
+
+void reportResults(const ProcessTable& table, const ScheduleResult& result, const string& title, ResultSink& sink) {
+    sink.begin(title);
+    for (size_t i = 0; i < table.size(); i++) {
+        Process p = table.toProcess(i);
+        p.remainingTime = result.remainingTime[i];
+        p.completionTime = result.completionTime[i];
+        p.turnaroundTime = result.turnaroundTime[i];
+        p.waitingTime = result.waitingTime[i];
+        p.startTime = result.startTime[i];
+        p.responseTime = result.responseTime[i];
+        sink.add(p);
+    }
+    sink.switches(result.contextSwitches, result.overheadTime);
+    if (table.hasIo())
+        sink.ioActivity(result.ioBusyTime, result.ioOverlapTime);
+    if (result.cpuCount > 1)
+        sink.cpus(result.cpuCount);
+    sink.end();
+}
+
+void reportResults(const vector<Process>& processes, const string& title, ResultSink& sink) {
+    sink.begin(title);
+    for (const auto& p : processes)
+        sink.add(p);
+    sink.end();
+}
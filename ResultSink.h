@@ -0,0 +1,188 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "Process.h"
+#include "ProcessTable.h"
+#include "QuantileSketch.h"
+
+/**
+ * Receives finished processes from a scheduling run
+ * Sinks see each process once, after its metrics are final.
+ */
+class ResultSink {
+public:
+    virtual ~ResultSink() {}
+
+    // Called once before the first process of a run
+    virtual void begin(const std::string& /*title*/) {}
+
+    // Called once per finished process
+    virtual void add(const Process& process) = 0;
+
+    // Called before end() by runs that count context switches, with the time they cost
+    virtual void switches(long long /*count*/, long long /*overheadTime*/) {}
+
+    // Called before end() by runs with I/O bursts: time any I/O was in progress, and the part of it the CPU was busy too
+    virtual void ioActivity(long long /*busyTime*/, long long /*overlapTime*/) {}
+
+    // Called before end() by runs on more than one CPU, with the number of CPUs
+    virtual void cpus(int /*count*/) {}
+
+    // Called once after the last process of a run
+    virtual void end() {}
+
+    // True if some results could not be written (a full disk, a closed pipe)
+    virtual bool failed() const { return false; }
+};
+
+/**
+ * Jain's fairness index of n values from their sum and sum of squares
+ * (sum)^2 / (n * sum of squares): 1 when every value is equal, down to 1/n
+ * when one value dominates. Computed over per-process slowdowns, it measures
+ * how evenly a policy spreads delay relative to job size.
+ */
+inline double jainIndex(double sum, double sumOfSquares, long long n) {
+    return n > 0 && sumOfSquares > 0 ? sum * sum / (n * sumOfSquares) : 1.0;
+}
+
+/**
+ * Running aggregates shared by the sinks that report averages and percentiles
+ * Times go into fixed-memory sketches, so no per-process values are kept.
+ */
+struct ResultTotals {
+    long long count = 0;
+    QuantileSketch turnaroundTime;
+    QuantileSketch waitingTime;
+    QuantileSketch responseTime;
+    int makespan = 0;
+    long long cpuTime = 0;   // sum of the CPU bursts
+    int cpuCount = 1;        // set by ResultSink::cpus
+
+    // Slowdown (turnaround / burst) sums for the fairness index
+    double totalSlowdown = 0.0;
+    double totalSquaredSlowdown = 0.0;
+    double maxSlowdown = 0.0;
+
+    // Set by ResultSink::switches; streamed runs do not count switches
+    bool switchesCounted = false;
+    long long contextSwitches = 0;
+    long long switchOverhead = 0;
+
+    // Set by ResultSink::ioActivity; only runs with I/O bursts report it
+    bool ioCounted = false;
+    long long ioBusyTime = 0;
+    long long ioOverlapTime = 0;
+
+    void add(const Process& p);
+    void addSwitches(long long count, long long overheadTime);
+    void addIo(long long busyTime, long long overlapTime);
+    double averageTurnaroundTime() const { return turnaroundTime.mean(); }
+    double averageWaitingTime() const { return waitingTime.mean(); }
+    double averageResponseTime() const { return responseTime.mean(); }
+    double averageSlowdown() const { return count ? totalSlowdown / count : 0.0; }
+    double fairnessIndex() const { return jainIndex(totalSlowdown, totalSquaredSlowdown, count); }
+    // Percentage of the makespan the CPUs spent running processes, averaged over the CPUs (switch overhead excluded)
+    double cpuUtilization() const { return makespan > 0 ? 100.0 * cpuTime / ((double)makespan * cpuCount) : 0.0; }
+    // Percentage of the I/O busy time during which the CPU was running a process too
+    double ioOverlap() const { return ioBusyTime > 0 ? 100.0 * ioOverlapTime / ioBusyTime : 0.0; }
+};
+
+/**
+ * Base for sinks that write text through a large output buffer
+ * The buffer is flushed with a single fwrite whenever it fills up.
+ */
+class BufferedResultSink : public ResultSink {
+public:
+    explicit BufferedResultSink(FILE* out);
+    ~BufferedResultSink();
+
+    bool failed() const override { return writeFailed || ferror(out); }
+
+protected:
+    void flushIfFull();
+    void flush();
+    // Flushes the buffer and the stream, at the end of a run
+    void finish();
+
+    FILE* out;
+    std::string buffer;
+    bool writeFailed = false;
+};
+
+// The colored box-drawing table of the interactive CLI
+class TableResultSink : public BufferedResultSink {
+public:
+    explicit TableResultSink(FILE* out) : BufferedResultSink(out) {}
+
+    void begin(const std::string& title) override;
+    void add(const Process& process) override;
+    void switches(long long count, long long overheadTime) override;
+    void ioActivity(long long busyTime, long long overlapTime) override;
+    void cpus(int count) override { totals.cpuCount = count; }
+    void end() override;
+
+private:
+    ResultTotals totals;
+};
+
+// One CSV row per process
+class CsvResultSink : public BufferedResultSink {
+public:
+    explicit CsvResultSink(FILE* out) : BufferedResultSink(out) {}
+
+    void begin(const std::string& title) override;
+    void add(const Process& process) override;
+    void end() override;
+
+private:
+    std::string quotedTitle;
+};
+
+// A JSON document with every process and the summary
+class JsonResultSink : public BufferedResultSink {
+public:
+    explicit JsonResultSink(FILE* out) : BufferedResultSink(out) {}
+
+    void begin(const std::string& title) override;
+    void add(const Process& process) override;
+    void switches(long long count, long long overheadTime) override;
+    void ioActivity(long long busyTime, long long overlapTime) override;
+    void cpus(int count) override { totals.cpuCount = count; }
+    void end() override;
+
+private:
+    ResultTotals totals;
+};
+
+// Only the aggregate metrics, as one CSV header and one row
+class SummaryResultSink : public BufferedResultSink {
+public:
+    explicit SummaryResultSink(FILE* out) : BufferedResultSink(out) {}
+
+    void begin(const std::string& title) override;
+    void add(const Process& process) override { totals.add(process); }
+    void switches(long long count, long long overheadTime) override;
+    void ioActivity(long long busyTime, long long overlapTime) override;
+    void cpus(int count) override { totals.cpuCount = count; }
+    void end() override;
+
+private:
+    std::string title;
+    ResultTotals totals;
+};
+
+/**
+ * Feeds the results of a run to a sink, in table order
+ *
+ * @param table Processes that were scheduled
+ * @param result Metrics of the run
+ * @param title Title of the scheduling algorithm
+ * @param sink Destination of the results
+ */
+void reportResults(const ProcessTable& table, const ScheduleResult& result, const std::string& title, ResultSink& sink);
+
+/**
+ * Feeds processes with calculated metrics to a sink
+ */
+void reportResults(const std::vector<Process>& processes, const std::string& title, ResultSink& sink);
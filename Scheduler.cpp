@@ -1,210 +1,485 @@
 #include "Scheduler.h"
+#include "SchedulingEngine.h"
 #include <algorithm>
 #include <queue>
-#include <iostream>
-#include "Utils.h"
+#include <functional>
+#include <deque>
 #include <climits>
+#include <cstdint>
 
 using namespace std;
 
+/*
+ * The algorithms run on a ProcessTable (one array per field) and address
+ * processes by their index in the arrival-sorted table. Per-run state and
+ * metrics are written to a ScheduleResult. The vector<Process> overloads at
+ * the bottom of this file are thin adapters over the table versions.
+ */
+
+const char* const ALGORITHM_TITLES[7] = {
+    "FCFS",
+    "SJF (Non-Preemptive)",
+    "Priority (Non-Preemptive)",
+    "Round Robin",
+    "SJF Preemptive (SRTF)",
+    "Priority Preemptive",
+    "Multi-Level Queue"
+};
+
+/*
+ * Heap keys of the table-based algorithms (smaller pops first), read when a
+ * process joins the ready queue; see HeapEntry
+ */
+
 /**
- * Comparator for SJF (Shortest Job First) priority queue
- * Creates a min-heap based on burst time
- * Tie-breaker: earlier arrival time has higher priority
+ * Key for SJF (Shortest Job First)
+ * Orders by the next CPU burst (the whole burst time unless the process
+ * does I/O)
+ * Tie-breaker: earlier arrival time
  */
-struct SJFComparator {
-    bool operator()(Process* a, Process* b) {
-        if (a->burstTime == b->burstTime)
-            return a->arrivalTime > b->arrivalTime; // Earlier arrival wins
-        return a->burstTime > b->burstTime; // Shorter burst time wins
+struct SJFKey {
+    const ProcessTable* table;
+    const ScheduleResult* result;
+
+    HeapEntry operator()(int i) const {
+        return { packKey(result->remainingTime[i], table->arrivalTime[i]), 0, i };
     }
 };
 
 /**
- * Comparator for Priority-based scheduling
- * Creates a min-heap based on priority value (lower value = higher priority)
+ * Key for Priority-based scheduling
+ * Orders by priority value (lower value = higher priority)
  * Tie-breakers: arrival time, then PID
  */
-struct PriorityComparator {
-    bool operator()(Process* a, Process* b) {
-        if (a->priority != b->priority)
-            return a->priority > b->priority;   // Lower priority value = higher priority
-        if (a->arrivalTime != b->arrivalTime)
-            return a->arrivalTime > b->arrivalTime; // Tie-breaker: earlier arrival
-        return a->pid > b->pid; // Tie-breaker: smaller PID
+struct PriorityKey {
+    const ProcessTable* table;
+
+    HeapEntry operator()(int i) const {
+        return { packKey(table->priority[i], table->arrivalTime[i]), (uint32_t)table->pid[i] ^ 0x80000000u, i };
     }
 };
 
+/**
+ * Key for SRTF (Shortest Remaining Time First)
+ * Orders by remaining time
+ * Tie-breakers: earlier arrival time, then earlier position in the input
+ */
+struct SRTFKey {
+    const ProcessTable* table;
+    const ScheduleResult* result;
 
+    HeapEntry operator()(int i) const {
+        return { packKey(result->remainingTime[i], table->arrivalTime[i]), (uint64_t)i, i };
+    }
+};
 
+/**
+ * Key for Priority Preemptive scheduling
+ * Orders by priority value (lower value = higher priority)
+ * Tie-breakers: shorter remaining time, earlier arrival, then earlier position in the input
+ */
+struct PreemptivePriorityKey {
+    const ProcessTable* table;
+    const ScheduleResult* result;
+
+    HeapEntry operator()(int i) const {
+        return { packKey(table->priority[i], result->remainingTime[i]), packKey(table->arrivalTime[i], i), i };
+    }
+};
 
+/* ================= POLICIES (see SchedulingEngine.h) ================= */
 
 /**
- * First-Come-First-Served (FCFS) Scheduling Algorithm
- * 
- * Processes are executed in the order they arrive in the ready queue.
- * This is the simplest scheduling algorithm - no preemption, no priority.
- * 
+ * Ready processes in FIFO order
+ * With the default unbounded quantum every CPU burst runs to its end: FCFS.
+ */
+struct FifoPolicy : PolicyDefaults {
+    IndexRing& readyQueue;
+
+    FifoPolicy(const ProcessTable& table, ScheduleResult& result) : readyQueue(result.readyQueues.fifo) {
+        readyQueue.reset(table.size());
+    }
+
+    bool empty() const { return readyQueue.empty(); }
+    void push(int i) { readyQueue.push_back(i); }
+    int pop() { return readyQueue.pop_front(); }
+
+    void save(CheckpointWriter& state) const { saveQueue(readyQueue, state); }
+    bool load(const ProcessTable& table, CheckpointReader& state) { return loadQueue(table, state, readyQueue); }
+};
+
+/**
+ * Ready processes in a heap ordered by Key, either run to the end of the CPU
+ * burst or preempted by every arrival and wakeup, after which the best
+ * process runs again
+ */
+template <typename Key, bool Preemptive>
+struct HeapPolicy : PolicyDefaults {
+    static const bool PREEMPTIVE = Preemptive;
+
+    Key key;
+    KeyedHeap& readyQueue;
+
+    HeapPolicy(const Key& key, ScheduleResult& result) : key(key), readyQueue(result.readyQueues.heap) {
+        readyQueue.clear();
+    }
+
+    bool empty() const { return readyQueue.empty(); }
+    void push(int i) { readyQueue.push(key(i)); }
+    int pop() { return readyQueue.pop(); }
+
+    void save(CheckpointWriter& state) const { saveQueue(readyQueue, state); }
+    bool load(const ProcessTable& table, CheckpointReader& state) { return loadQueue(table, state, readyQueue); }
+};
+
+/**
+ * Checks whether a bucket per priority value pops processes in PriorityKey order
+ *
+ * That is the case when every process joins the ready queue once, in table
+ * order (no I/O: wakeups come out of arrival order), and the table lists
+ * processes of equal arrival time by increasing PID, so that FIFO order
+ * within a bucket is the arrival/PID tie-break. The priorities must also
+ * span at most MAX_BITMAP_LEVELS values.
+ *
  * Time Complexity: O(n) where n is the number of processes
- * Space Complexity: O(1)
- * 
- * @param processes Vector of processes to schedule (must be sorted by arrival time)
+ *
+ * @param lowest Receives the smallest priority value (bucket 0)
+ * @param buckets Receives the number of buckets
+ * @return false if the heap must be used instead
  */
-void FCFS(vector<Process>& processes)
+static bool priorityBucketsApply(const ProcessTable& table, int& lowest, int& buckets)
 {
-    int currentTime = 0; // Tracks the current CPU time during simulation
+    if (table.hasIo() || table.size() == 0)
+        return false;
+    const vector<int>& priority = table.priority;
+    int highest = priority[0];
+    lowest = priority[0];
+    for (size_t i = 1; i < table.size(); i++) {
+        if (table.arrivalTime[i] == table.arrivalTime[i - 1] && table.pid[i] <= table.pid[i - 1])
+            return false;
+        lowest = min(lowest, priority[i]);
+        highest = max(highest, priority[i]);
+    }
+    if ((long long)highest - lowest >= MAX_BITMAP_LEVELS)
+        return false;
+    buckets = highest - lowest + 1;
+    return true;
+}
 
-    // Execute processes in order of arrival
-    for (auto& process : processes)
+/**
+ * Ready processes in PriorityKey order: O(1) bucket queue (one FIFO per
+ * priority value) when priorityBucketsApply, keyed heap otherwise
+ */
+class PriorityReadyQueue {
+public:
+    PriorityReadyQueue(const ProcessTable& table, ScheduleResult& result)
+        : table(table), key{ &table }, heap(result.readyQueues.heap), bucketQueue(result.readyQueues.buckets)
     {
-        // If CPU is idle, wait until the process arrives
-        if (currentTime < process.arrivalTime)
-            currentTime = process.arrivalTime;
+        int buckets = 0;
+        useBuckets = priorityBucketsApply(table, lowest, buckets);
+        if (useBuckets)
+            bucketQueue.reset(buckets, table.size());
+        else
+            heap.clear();
+    }
 
-        // Execute the process completely (advance currentTime by Burst Time)
-        currentTime += process.burstTime;
+    bool empty() const { return useBuckets ? bucketQueue.empty() : heap.empty(); }
 
-        // Calculate performance metrics
-        process.completionTime = currentTime;
-        process.turnaroundTime = process.completionTime - process.arrivalTime;
-        process.waitingTime = process.turnaroundTime - process.burstTime;
+    void push(int i) {
+        if (useBuckets)
+            bucketQueue.push(table.priority[i] - lowest, i);
+        else
+            heap.push(key(i));
     }
 
-    printResults(processes, "FCFS");
-}
+    int pop() { return useBuckets ? bucketQueue.pop() : heap.pop(); }
+
+    // The structure in use follows from the table, so a checkpoint only holds its contents
+    void save(CheckpointWriter& state) const {
+        if (useBuckets)
+            saveQueue(bucketQueue, state);
+        else
+            saveQueue(heap, state);
+    }
+
+    bool load(const ProcessTable& table, CheckpointReader& state) {
+        return useBuckets ? loadQueue(table, state, bucketQueue) : loadQueue(table, state, heap);
+    }
+
+private:
+    const ProcessTable& table;
+    PriorityKey key;
+    KeyedHeap& heap;
+    BucketQueue& bucketQueue;
+    bool useBuckets = false;
+    int lowest = 0;
+};
+
+// Priority Non-Preemptive: every CPU burst runs to its end
+struct PriorityPolicy : PolicyDefaults {
+    PriorityReadyQueue readyQueue;
+
+    PriorityPolicy(const ProcessTable& table, ScheduleResult& result) : readyQueue(table, result) {}
+
+    bool empty() const { return readyQueue.empty(); }
+    void push(int i) { readyQueue.push(i); }
+    int pop() { return readyQueue.pop(); }
+
+    void save(CheckpointWriter& state) const { readyQueue.save(state); }
+    bool load(const ProcessTable& table, CheckpointReader& state) { return readyQueue.load(table, state); }
+};
 
 /**
- * Shortest Job First (SJF) Non-Preemptive Scheduling Algorithm
+ * Skips whole Round Robin rounds in which nothing but quantum expiries can happen
  * 
- * Selects the process with the shortest burst time from the ready queue.
- * Once a process starts executing, it runs to completion (non-preemptive).
+ * If no process in the ready queue can finish and no new process can arrive
+ * during the next k full rounds, every process simply runs k quanta and the
+ * queue ends up in the same order. Those rounds are applied arithmetically.
  * 
- * Time Complexity: O(n log n) where n is the number of processes
- * Space Complexity: O(n) for the priority queue
+ * Time Complexity: O(m) where m is the ready queue size
  * 
- * @param processes Vector of processes to schedule (must be sorted by arrival time)
+ * @param readyQueue Current Round Robin ready queue (table indices)
+ * @param remaining Remaining time of every process
+ * @param currentTime Current CPU time, advanced past the skipped rounds
+ * @param timeQuantum Fixed time slice allocated to each process
+ * @param sliceOverhead Switching overhead before every slice of the rounds
+ * @param nextArrival Arrival time of the next process, or INT_MAX if none is left
+ * @return Number of rounds skipped
  */
-void SJF_NonPreemptive(vector<Process>& processes)
+static long long fastForwardRounds(const IndexRing& readyQueue, vector<int>& remaining,
+    int& currentTime, int timeQuantum, int sliceOverhead, int nextArrival)
 {
-    // Priority queue (min-heap) based on burst time
-    // Shorter burst time = higher priority
-    priority_queue<Process*, vector<Process*>, SJFComparator> readyQueue;
-
-    int currentTime = 0;
-    int completed = 0;
-    int nextIndex = 0;
-    int n = processes.size();
+    size_t m = readyQueue.size();
+    int minRemaining = INT_MAX;
+    for (size_t k = 0; k < m; k++)
+        minRemaining = min(minRemaining, remaining[readyQueue[k]]);
+
+    // Every process must still have work left after the skipped rounds
+    long long rounds = (minRemaining - 1) / timeQuantum;
+
+    // The last skipped slice must end before the next arrival
+    long long roundLength = (long long)m * (timeQuantum + sliceOverhead);
+    if (nextArrival != INT_MAX)
+        rounds = min(rounds, (nextArrival - currentTime - 1) / roundLength);
+    rounds = min(rounds, (INT_MAX - currentTime) / roundLength);
+
+    if (rounds <= 0)
+        return 0;
+
+    for (size_t k = 0; k < m; k++)
+        remaining[readyQueue[k]] -= (int)(rounds * timeQuantum);
+    currentTime += (int)(rounds * roundLength);
+    return rounds;
+}
 
-    // Simulation loop: continue until all processes are completed
-    while (completed < n)
-    {
-        // Add all processes that have arrived by currentTime to ready queue
-        while (nextIndex < n && processes[nextIndex].arrivalTime <= currentTime) {
-            readyQueue.push(&processes[nextIndex]);
-            nextIndex++;
+/**
+ * Writes the slices of rounds skipped by fastForwardRounds to the timeline
+ * A single process in the queue becomes one segment; otherwise every slice
+ * is a segment of its own, after its switching overhead. (The run statistics
+ * of the skipped rounds are applied by the caller in one step.)
+ */
+static void recordSkippedRounds(const ProcessTable& table, Timeline& timeline,
+    const IndexRing& readyQueue, int start, long long rounds, int timeQuantum, int sliceOverhead)
+{
+    if (readyQueue.size() == 1) {
+        int p = readyQueue.front();
+        timeline.record(p, table.pid[p], start, start + (int)(rounds * timeQuantum));
+        return;
+    }
+    int time = start;
+    for (long long r = 0; r < rounds; r++) {
+        for (size_t k = 0; k < readyQueue.size(); k++) {
+            int p = readyQueue[k];
+            time += sliceOverhead;
+            timeline.record(p, table.pid[p], time, time + timeQuantum);
+            time += timeQuantum;
         }
+    }
+}
 
-        // CPU idle case: no process is ready
-        if (readyQueue.empty()) {
-            if (nextIndex < n) {
-                // Jump to next arrival time
-                currentTime = processes[nextIndex].arrivalTime;
-            } else {
-                // All processes have arrived but not completed (shouldn't happen)
-                break;
-            }
-            continue;
+// Number of queued processes that have already been dispatched once
+static long long startedCount(const ScheduleResult& result, const IndexRing& readyQueue) {
+    long long started = 0;
+    for (size_t k = 0; k < readyQueue.size(); k++)
+        started += result.startTime[readyQueue[k]] >= 0;
+    return started;
+}
+
+/**
+ * FIFO order with a fixed quantum
+ * Once per round (before the first dispatch of every m slices, for a queue
+ * of m) it fast-forwards over rounds that contain no arrival, I/O completion
+ * or end of a CPU burst (see fastForwardRounds). Only rounds in which every
+ * slice costs the same switching overhead are skipped: every queued process
+ * has already run (so each resume pays the cache warm-up), or a lone process
+ * keeps the CPU.
+ */
+struct RoundRobinPolicy : FifoPolicy {
+    int timeQuantum;
+    size_t slicesUntilCheck = 0;   // slices left until the next fast-forward attempt
+
+    RoundRobinPolicy(const ProcessTable& table, ScheduleResult& result, int timeQuantum)
+        : FifoPolicy(table, result), timeQuantum(timeQuantum) {}
+
+    int quantum(int /*i*/) const { return timeQuantum; }
+
+    void beforeDispatch(const ProcessTable& table, ScheduleResult& result, int& currentTime, int nextIndex) {
+        if (slicesUntilCheck-- > 0)
+            return;
+
+        // With several processes every slice must be a switch (the front
+        // did not run last, which it can after waking from I/O); a lone
+        // process must already hold the CPU
+        long long m = readyQueue.size();
+        bool uniform = m > 1
+            ? readyQueue.front() != result.lastDispatched && startedCount(result, readyQueue) == m
+            : readyQueue.front() == result.lastDispatched;
+        int sliceOverhead = m > 1 ? result.switchCost.contextSwitch + result.switchCost.cacheWarmup : 0;
+
+        int roundsStart = currentTime;
+        long long rounds = !uniform ? 0 : fastForwardRounds(readyQueue, result.remainingTime, currentTime, timeQuantum,
+            sliceOverhead, nextEventTime(table, result, nextIndex));
+        if (rounds > 0 && m > 1) {
+            // The skipped slices ran the queue front to back, rounds times
+            result.contextSwitches += rounds * m;
+            result.overheadTime += rounds * m * sliceOverhead;
+            result.lastDispatched = readyQueue.back();
         }
+        // No I/O finishes during the skipped rounds: either some is still running through all of them, or none is
+        if (rounds > 0 && result.ioEnd > roundsStart)
+            result.ioOverlapTime += rounds * m * timeQuantum;
+        if (rounds > 0 && result.timeline)
+            recordSkippedRounds(table, *result.timeline, readyQueue, roundsStart, rounds, timeQuantum, sliceOverhead);
+        slicesUntilCheck = readyQueue.size() - 1;
+    }
 
-        // Select process with shortest burst time
-        Process* selected = readyQueue.top();
-        readyQueue.pop();
+    void save(CheckpointWriter& state) const {
+        FifoPolicy::save(state);
+        state.put((uint64_t)slicesUntilCheck);
+    }
 
-        // Execute process completely (non-preemptive)
-        currentTime += selected->burstTime;
+    bool load(const ProcessTable& table, CheckpointReader& state) {
+        uint64_t slices;
+        if (!FifoPolicy::load(table, state) || !state.get(slices))
+            return false;
+        slicesUntilCheck = (size_t)slices;
+        return true;
+    }
+};
 
-        // Calculate performance metrics
-        selected->completionTime = currentTime;
-        selected->turnaroundTime = selected->completionTime - selected->arrivalTime;
-        selected->waitingTime = selected->turnaroundTime - selected->burstTime;
+/**
+ * One ready queue per process type, served in priority order:
+ * SYSTEM (Round Robin, quantum 2), then INTERACTIVE (Priority Non-Preemptive),
+ * then BATCH (FCFS)
+ */
+struct MultiLevelQueuePolicy : PolicyDefaults {
+    static const int SYSTEM_QUANTUM = 2;
 
-        completed++;
+    const ProcessTable& table;
+    IndexRing& systemQueue;
+    PriorityReadyQueue interactiveQueue;
+    IndexRing& batchQueue;
 
-        // IMPORTANT: Add any processes that arrived during execution
-        while (nextIndex < n && processes[nextIndex].arrivalTime <= currentTime) {
-            readyQueue.push(&processes[nextIndex]);
-            nextIndex++;
-        }
+    MultiLevelQueuePolicy(const ProcessTable& table, ScheduleResult& result)
+        : table(table), systemQueue(result.readyQueues.fifo), interactiveQueue(table, result),
+          batchQueue(result.readyQueues.secondFifo)
+    {
+        systemQueue.reset(table.size());
+        batchQueue.reset(table.size());
+    }
+
+    bool empty() const { return systemQueue.empty() && interactiveQueue.empty() && batchQueue.empty(); }
+
+    void push(int i) {
+        if (table.queueType[i] == SYSTEM)
+            systemQueue.push_back(i);
+        else if (table.queueType[i] == INTERACTIVE)
+            interactiveQueue.push(i);
+        else
+            batchQueue.push_back(i);
+    }
+
+    int pop() {
+        if (!systemQueue.empty())
+            return systemQueue.pop_front();
+        if (!interactiveQueue.empty())
+            return interactiveQueue.pop();
+        return batchQueue.pop_front();
     }
 
-    printResults(processes, "SJF (Non-Preemptive)");
+    int quantum(int i) const { return table.queueType[i] == SYSTEM ? SYSTEM_QUANTUM : INT_MAX; }
+
+    void save(CheckpointWriter& state) const {
+        saveQueue(systemQueue, state);
+        interactiveQueue.save(state);
+        saveQueue(batchQueue, state);
+    }
+
+    bool load(const ProcessTable& table, CheckpointReader& state) {
+        return loadQueue(table, state, systemQueue) && interactiveQueue.load(table, state)
+            && loadQueue(table, state, batchQueue);
+    }
+};
+
+/* ================= ALGORITHMS ================= */
+
+/**
+ * First-Come-First-Served (FCFS) Scheduling Algorithm
+ * 
+ * Processes are executed in the order they arrive in the ready queue.
+ * This is the simplest scheduling algorithm - no preemption, no priority.
+ * With I/O bursts, a process rejoins the back of the queue when its I/O finishes.
+ * 
+ * Time Complexity: O(n) where n is the number of processes
+ * Space Complexity: O(n) for the ready queue
+ * 
+ * @param table Processes to schedule (must be sorted by arrival time)
+ * @param result Per-run state and metrics (reset by this function)
+ */
+void FCFS(const ProcessTable& table, ScheduleResult& result)
+{
+    FifoPolicy policy(table, result);
+    runPolicy(table, result, policy);
 }
 
 /**
- * Priority Non-Preemptive Scheduling Algorithm
+ * Shortest Job First (SJF) Non-Preemptive Scheduling Algorithm
  * 
- * Selects the process with the highest priority (lowest priority value) from the ready queue.
+ * Selects the process with the shortest burst time from the ready queue.
  * Once a process starts executing, it runs to completion (non-preemptive).
  * 
  * Time Complexity: O(n log n) where n is the number of processes
  * Space Complexity: O(n) for the priority queue
  * 
- * @param processes Vector of processes to schedule (must be sorted by arrival time)
+ * @param table Processes to schedule (must be sorted by arrival time)
+ * @param result Per-run state and metrics (reset by this function)
  */
-void Priority_NonPreemptive(vector<Process>& processes)
+void SJF_NonPreemptive(const ProcessTable& table, ScheduleResult& result)
 {
-    // Priority queue (min-heap) based on priority value
-    // Lower priority value = higher priority
-    priority_queue<Process*, vector<Process*>, PriorityComparator> readyQueue;
-
-    int currentTime = 0;
-    int completed = 0;
-    int nextIndex = 0;
-    int n = processes.size();
-
-    // Simulation loop: continue until all processes are completed
-    while (completed < n)
-    {
-        // Add all processes that have arrived by currentTime to ready queue
-        while (nextIndex < n && processes[nextIndex].arrivalTime <= currentTime) {
-            readyQueue.push(&processes[nextIndex]);
-            nextIndex++;
-        }
-
-        // CPU idle case: no process is ready
-        if (readyQueue.empty()) {
-            if (nextIndex < n) {
-                // Jump to next arrival time
-                currentTime = processes[nextIndex].arrivalTime;
-            } else {
-                // All processes have arrived but not completed (shouldn't happen)
-                break;
-            }
-            continue;
-        }
-
-        // Select process with highest priority (lowest priority value)
-        Process* selected = readyQueue.top();
-        readyQueue.pop();
-
-        // Execute process completely (non-preemptive)
-        currentTime += selected->burstTime;
-
-        // Calculate performance metrics
-        selected->completionTime = currentTime;
-        selected->turnaroundTime = selected->completionTime - selected->arrivalTime;
-        selected->waitingTime = selected->turnaroundTime - selected->burstTime;
-
-        completed++;
-
-        // IMPORTANT: Add any processes that arrived during execution
-        while (nextIndex < n && processes[nextIndex].arrivalTime <= currentTime) {
-            readyQueue.push(&processes[nextIndex]);
-            nextIndex++;
-        }
-    }
+    // Min-heap on the next CPU burst (ties: earlier arrival)
+    HeapPolicy<SJFKey, false> policy(SJFKey{ &table, &result }, result);
+    runPolicy(table, result, policy);
+}
 
-    printResults(processes, "Priority (Non-Preemptive)");
+/**
+ * Priority Non-Preemptive Scheduling Algorithm
+ * 
+ * Selects the process with the highest priority (lowest priority value) from the ready queue.
+ * Once a process starts executing, it runs to completion (non-preemptive).
+ * The ready queue is a bucket per priority value when the priorities span
+ * a bounded range (see PriorityReadyQueue), a heap otherwise.
+ * 
+ * Time Complexity: O(n) with buckets, O(n log n) with the heap, where n is the number of processes
+ * Space Complexity: O(n) for the priority queue
+ * 
+ * @param table Processes to schedule (must be sorted by arrival time)
+ * @param result Per-run state and metrics (reset by this function)
+ */
+void Priority_NonPreemptive(const ProcessTable& table, ScheduleResult& result)
+{
+    // Ordered by (priority, arrival time, PID)
+    PriorityPolicy policy(table, result);
+    runPolicy(table, result, policy);
 }
 
 /**
@@ -214,77 +489,19 @@ void Priority_NonPreemptive(vector<Process>& processes)
  * within its quantum, it's preempted and moved to the end of the queue.
  * This ensures fair CPU allocation and prevents starvation.
  * 
- * Time Complexity: O(n × q) where n is number of processes, q is time quantum
+ * Rounds in which nothing but quantum expiries can happen are skipped
+ * arithmetically (see RoundRobinPolicy).
+ * 
+ * Time Complexity: O(n + s) where n is number of processes, s is the number of simulated time slices
  * Space Complexity: O(n) for the ready queue
  * 
- * @param processes Vector of processes to schedule (must be sorted by arrival time)
+ * @param table Processes to schedule (must be sorted by arrival time)
+ * @param result Per-run state and metrics (reset by this function)
  * @param timeQuantum Fixed time slice allocated to each process
  */
-void RoundRobin(vector<Process>& processes, int timeQuantum) {
-    int n = processes.size();
-    int currentTime = 0;
-    int completed = 0;
-
-    queue<Process*> readyQueue;
-
-    // Keep track of which processes have arrived
-    vector<bool> inQueue(n, false);
-
-    while (completed < n)
-    {
-        // Add arrived processes to the queue
-        for (int i = 0; i < n; i++) {
-            if (!inQueue[i] && processes[i].arrivalTime <= currentTime) {
-                readyQueue.push(&processes[i]);
-                inQueue[i] = true;
-            }
-        }
-
-        // CPU idle case
-        if (readyQueue.empty()) {
-            // Move currentTime to the arrival time of the next process
-            int nextArrival = INT_MAX;
-            for (int i = 0; i < n; i++) {
-                if (!inQueue[i] && processes[i].arrivalTime < nextArrival) {
-                    nextArrival = processes[i].arrivalTime;
-                }
-            }
-            currentTime = nextArrival;
-            continue;
-        }
-
-        // Get the first process from the queue
-        Process* p = readyQueue.front();
-        readyQueue.pop();
-
-        // Execute for min(remainingTime, timeQuantum)
-        int execTime = min(p->remainingTime, timeQuantum);
-        p->remainingTime -= execTime;
-        currentTime += execTime;
-
-        // Add newly arrived processes to the queue during this time slice
-        for (int i = 0; i < n; i++) {
-            if (!inQueue[i] && processes[i].arrivalTime <= currentTime) {
-                readyQueue.push(&processes[i]);
-                inQueue[i] = true;
-            }
-        }
-
-        // If process is not finished, push it back to the queue
-        if (p->remainingTime > 0) {
-            readyQueue.push(p);
-        }
-        else {
-            // Process completed
-            p->completionTime = currentTime;
-            p->turnaroundTime = p->completionTime - p->arrivalTime;
-            p->waitingTime = p->turnaroundTime - p->burstTime;
-            completed++;
-        }
-    }
-
-    // Print results
-    printResults(processes, "Round Robin");
+void RoundRobin(const ProcessTable& table, ScheduleResult& result, int timeQuantum) {
+    RoundRobinPolicy policy(table, result, timeQuantum);
+    runPolicy(table, result, policy);
 }
 
 /**
@@ -294,283 +511,543 @@ void RoundRobin(vector<Process>& processes, int timeQuantum) {
  * If a new process arrives with shorter remaining time, current process is preempted.
  * This is optimal for minimizing average waiting time in preemptive scheduling.
  * 
- * Time Complexity: O(n² × max_bt) where n is number of processes, max_bt is max burst time
+ * Event-driven: the running process only shrinks its own remaining time, so
+ * it stays the best candidate until the next arrival or wakeup, and time
+ * jumps straight to that event or to the end of the CPU burst.
+ * 
+ * Time Complexity: O(n log n) where n is the number of processes
+ * Space Complexity: O(n) for the ready queue
+ * 
+ * @param table Processes to schedule (must be sorted by arrival time)
+ * @param result Per-run state and metrics (reset by this function)
+ */
+void SJF_Preemptive(const ProcessTable& table, ScheduleResult& result) {
+    // Min-heap on remaining time (ties: earlier arrival, then input order)
+    HeapPolicy<SRTFKey, true> policy(SRTFKey{ &table, &result }, result);
+    runPolicy(table, result, policy);
+}
+
+/**
+ * Priority Preemptive Scheduling Algorithm
+ * 
+ * Always executes the process with the highest priority (lowest priority value).
+ * If a new process arrives with higher priority, current process is preempted.
+ * Suitable for real-time systems where priority matters.
+ * 
+ * Event-driven: time jumps straight to the next arrival, wakeup or end of
+ * a CPU burst (see SJF_Preemptive).
+ * 
+ * Time Complexity: O(n log n) where n is the number of processes
+ * Space Complexity: O(n) for the ready queue
+ * 
+ * @param table Processes to schedule (must be sorted by arrival time)
+ * @param result Per-run state and metrics (reset by this function)
+ */
+void Priority_Preemptive(const ProcessTable& table, ScheduleResult& result) {
+    // Min-heap on (priority, remaining time, arrival time, input order)
+    HeapPolicy<PreemptivePriorityKey, true> policy(PreemptivePriorityKey{ &table, &result }, result);
+    runPolicy(table, result, policy);
+}
+
+/**
+ * Multi-Level Queue Scheduling Algorithm
+ * 
+ * Divides processes into multiple queues based on process type:
+ * - SYSTEM Queue: Round Robin with time quantum = 2 (highest priority)
+ * - INTERACTIVE Queue: Priority Non-Preemptive (medium priority), bucket queue or heap
+ *   as for Priority_NonPreemptive
+ * - BATCH Queue: FCFS (lowest priority)
+ * 
+ * Queues are served in priority order (SYSTEM > INTERACTIVE > BATCH)
+ * 
+ * Time Complexity: O(n × q) where n is number of processes, q is time quantum
  * Space Complexity: O(n)
  * 
- * @param processes Vector of processes to schedule (must be sorted by arrival time)
+ * @param table Processes to schedule (must be sorted by arrival time)
+ * @param result Per-run state and metrics (reset by this function)
  */
-void SJF_Preemptive(vector<Process>& processes) {
-    int n = processes.size();
-    int completed = 0;
-    int currentTime = 0;
+void MultiLevelQueue(const ProcessTable& table, ScheduleResult& result) {
+    MultiLevelQueuePolicy policy(table, result);
+    runPolicy(table, result, policy);
+}
 
-    vector<bool> isCompleted(n, false);
+/**
+ * FIFO queues of table indices, one per level, as intrusive linked lists
+ * Besides O(1) push and pop, a whole level can be appended to another one in
+ * O(1), which is what makes a priority boost cost O(levels) instead of O(n).
+ */
+class LevelQueues {
+public:
+    LevelQueues(int levels, int n) : head(levels, -1), tail(levels, -1), next(n, -1), prev(n, -1), bitmap(levels) {}
+
+    bool empty() const { return bitmap.empty(); }
+    int highest() const { return bitmap.first(); }
+    int front(int level) const { return head[level]; }
+
+    void push(int level, int p) {
+        next[p] = -1;
+        prev[p] = tail[level];
+        if (tail[level] >= 0)
+            next[tail[level]] = p;
+        else
+            head[level] = p;
+        tail[level] = p;
+        bitmap.set(level);
+    }
 
-    while (completed < n)
-    {
-        int idx = -1;
-        int minRemaining = INT_MAX;
-
-        // Find process with minimum remainingTime that has arrived
-        for (int i = 0; i < n; i++) {
-            if (!isCompleted[i] && processes[i].arrivalTime <= currentTime) {
-                if (processes[i].remainingTime < minRemaining) {
-                    minRemaining = processes[i].remainingTime;
-                    idx = i;
-                }
-                else if (processes[i].remainingTime == minRemaining) {
-                    // tie-breaker: earlier arrival
-                    if (processes[i].arrivalTime < processes[idx].arrivalTime) {
-                        idx = i;
-                    }
-                }
-            }
-        }
+    void pushFront(int level, int p) {
+        prev[p] = -1;
+        next[p] = head[level];
+        if (head[level] >= 0)
+            prev[head[level]] = p;
+        else
+            tail[level] = p;
+        head[level] = p;
+        bitmap.set(level);
+    }
 
-        if (idx == -1) {
-            // No process ready ? CPU idle
-            currentTime++;
-            continue;
-        }
+    void remove(int level, int p) {
+        if (prev[p] >= 0) next[prev[p]] = next[p]; else head[level] = next[p];
+        if (next[p] >= 0) prev[next[p]] = prev[p]; else tail[level] = prev[p];
+        if (head[level] < 0)
+            bitmap.clear(level);
+    }
 
-        // Execute the process for 1 unit of time
-        processes[idx].remainingTime--;
-        currentTime++;
-
-        // If process finished
-        if (processes[idx].remainingTime == 0) {
-            processes[idx].completionTime = currentTime;
-            processes[idx].turnaroundTime = processes[idx].completionTime - processes[idx].arrivalTime;
-            processes[idx].waitingTime = processes[idx].turnaroundTime - processes[idx].burstTime;
-            isCompleted[idx] = true;
-            completed++;
+    // Moves every process of level from to the back of level to, keeping their order
+    void splice(int from, int to) {
+        if (head[from] < 0 || from == to)
+            return;
+        if (tail[to] >= 0) {
+            next[tail[to]] = head[from];
+            prev[head[from]] = tail[to];
         }
+        else {
+            head[to] = head[from];
+        }
+        tail[to] = tail[from];
+        head[from] = tail[from] = -1;
+        bitmap.clear(from);
+        bitmap.set(to);
     }
 
-    printResults(processes, "SJF Preemptive (SRTF)");
+private:
+    vector<int> head, tail;
+    vector<int> next, prev;
+    LevelBitmap bitmap;
+};
+
+const char* const MLFQ_TITLE = "Multi-Level Feedback Queue";
+
+bool validateMlfqOptions(const MlfqOptions& options, string& error) {
+    if (options.quanta.empty() || options.quanta.size() > (size_t)MLFQ_MAX_LEVELS) {
+        error = "MLFQ needs 1 to " + to_string(MLFQ_MAX_LEVELS) + " levels";
+        return false;
+    }
+    for (int quantum : options.quanta) {
+        if (quantum <= 0) {
+            error = "MLFQ quanta must be positive integers";
+            return false;
+        }
+    }
+    if (options.boostInterval < 0 || options.agingThreshold < 0) {
+        error = "MLFQ boost interval and aging threshold must not be negative";
+        return false;
+    }
+    return true;
 }
 
 /**
- * Priority Preemptive Scheduling Algorithm
+ * Multi-Level Feedback Queue (MLFQ) Scheduling Algorithm
  * 
- * Always executes the process with the highest priority (lowest priority value).
- * If a new process arrives with higher priority, current process is preempted.
- * Suitable for real-time systems where priority matters.
+ * Processes enter the highest level (0) and the highest non-empty level
+ * always runs, Round Robin within a level. A process that uses up the quantum
+ * of its level moves one level down; one preempted earlier keeps its level and
+ * the quantum it has used. An arrival preempts a process running below level 0.
+ * - Boost: every boostInterval time units all processes return to level 0
+ *   with a fresh quantum (against starvation of the lowest levels).
+ * - Aging: a process that waited agingThreshold time units in a queue moves
+ *   one level up, and can keep climbing one level per threshold.
  * 
- * Time Complexity: O(n² × max_bt) where n is number of processes, max_bt is max burst time
- * Space Complexity: O(n)
+ * The highest non-empty level comes from a bitmap (find-first-set), levels are
+ * spliced in O(1) on a boost, and aging checks only the longest waiting
+ * process: all queue entries below level 0 sit in one FIFO in the order they
+ * were queued, which is also the order of their waiting times.
  * 
- * @param processes Vector of processes to schedule (must be sorted by arrival time)
+ * Time Complexity: O(n + s + b × L) where s is the number of time slices,
+ *                  b the number of boosts and L the number of levels
+ * Space Complexity: O(n + L)
+ * 
+ * @param table Processes to schedule (must be sorted by arrival time)
+ * @param result Per-run state and metrics (reset by this function)
+ * @param options Validated level quanta, boost interval and aging threshold
  */
-void Priority_Preemptive(vector<Process>& processes) {
-    int n = processes.size();
-    int completed = 0;
+void MultiLevelFeedbackQueue(const ProcessTable& table, ScheduleResult& result, const MlfqOptions& options) {
+    result.reset(table);
+
+    const vector<int>& arrival = table.arrivalTime;
+    vector<int>& remaining = result.remainingTime;
+    const vector<int>& quanta = options.quanta;
+    int levels = (int)quanta.size();
+    int n = table.size();
     int currentTime = 0;
+    int completed = 0;
+    int nextIndex = 0;
+
+    LevelQueues queues(levels, n);
+    vector<int> level(n, 0);
+    vector<int> used(n, 0);        // quantum used at the current level
+    vector<int> usedEpoch(n, 0);   // boost epoch in which used was last updated
+    int epoch = 0;
+    long long nextBoost = options.boostInterval > 0 ? options.boostInterval : LLONG_MAX;
+
+    // Aging: (process, time queued, queue stamp); stale once the process leaves that queue
+    struct Waiting { int process; int since; int stamp; };
+    deque<Waiting> waiting;
+    vector<int> stamp(n, 0);
+
+    auto enqueue = [&](int p, int toLevel, bool front = false) {
+        level[p] = toLevel;
+        if (front)
+            queues.pushFront(toLevel, p);
+        else
+            queues.push(toLevel, p);
+        stamp[p]++;
+        if (options.agingThreshold > 0 && toLevel > 0) {
+            Waiting entry = { p, currentTime, stamp[p] };
+            waiting.push_back(entry);
+        }
+    };
 
-    vector<bool> isCompleted(n, false);
+    // Arrivals start at level 0; a process back from I/O keeps its level and
+    // used quantum, unless a boost happened while it was blocked
+    auto admitArrivals = [&]() {
+        admitReady(table, result, nextIndex, currentTime, [&](int p) {
+            enqueue(p, usedEpoch[p] == epoch ? level[p] : 0);
+        });
+    };
 
-    while (completed < n)
+    while (completed < n && !result.clockOverflow)
     {
-        int idx = -1;
-        int highestPriority = INT_MAX;
-
-        // Find process with highest priority (lowest value) that has arrived
-        for (int i = 0; i < n; i++) {
-            if (!isCompleted[i] && processes[i].arrivalTime <= currentTime) {
-                if (processes[i].priority < highestPriority) {
-                    highestPriority = processes[i].priority;
-                    idx = i;
-                }
-                else if (processes[i].priority == highestPriority) {
-                    // tie-breaker: shorter remainingTime
-                    if (processes[i].remainingTime < processes[idx].remainingTime) {
-                        idx = i;
-                    }
-                    else if (processes[i].remainingTime == processes[idx].remainingTime) {
-                        // tie-breaker: earlier arrival
-                        if (processes[i].arrivalTime < processes[idx].arrivalTime) {
-                            idx = i;
-                        }
-                    }
-                }
+        admitArrivals();
+
+        if (currentTime >= nextBoost) {
+            // Everything moves to level 0 in level order; waiting entries and used quanta expire
+            for (int l = 1; l < levels; l++)
+                queues.splice(l, 0);
+            epoch++;
+            waiting.clear();
+            nextBoost = ((long long)currentTime / options.boostInterval + 1) * options.boostInterval;
+        }
+
+        // Promote the processes that waited long enough, longest waiting first
+        while (!waiting.empty()) {
+            const Waiting& oldest = waiting.front();
+            if (oldest.stamp != stamp[oldest.process]) {
+                waiting.pop_front();
+                continue;
             }
+            if (currentTime - oldest.since < options.agingThreshold)
+                break;
+            int p = oldest.process;
+            waiting.pop_front();
+            queues.remove(level[p], p);
+            used[p] = 0;
+            enqueue(p, level[p] - 1);
         }
 
-        if (idx == -1) {
-            // CPU idle
-            currentTime++;
+        // CPU idle case: jump to the next arrival or I/O completion
+        if (queues.empty()) {
+            currentTime = nextEventTime(table, result, nextIndex);
             continue;
         }
 
-        // Execute for 1 time unit
-        processes[idx].remainingTime--;
-        currentTime++;
-
-        // If process finished
-        if (processes[idx].remainingTime == 0) {
-            processes[idx].completionTime = currentTime;
-            processes[idx].turnaroundTime = processes[idx].completionTime - processes[idx].arrivalTime;
-            processes[idx].waitingTime = processes[idx].turnaroundTime - processes[idx].burstTime;
-            isCompleted[idx] = true;
-            completed++;
+        int l = queues.highest();
+        int p = queues.front(l);
+        queues.remove(l, p);
+        level[p] = l;   // a boost may have moved it
+        stamp[p]++;
+        if (usedEpoch[p] != epoch) {
+            used[p] = 0;
+            usedEpoch[p] = epoch;
+        }
+        int overhead = result.dispatch(p);
+        if (!result.fitsClock((long long)currentTime + overhead))
+            return;
+        currentTime += overhead;
+
+        // Run for the rest of the quantum, unless the CPU burst ends, an
+        // arrival or wakeup may preempt it (below level 0) or a boost is due
+        long long sliceEnd = (long long)currentTime + min(quanta[l] - used[p], remaining[p]);
+        if (l > 0 && nextIndex < n)
+            sliceEnd = min(sliceEnd, (long long)arrival[nextIndex]);
+        if (l > 0)
+            sliceEnd = min(sliceEnd, (long long)result.nextWakeup());
+        sliceEnd = min(sliceEnd, nextBoost);
+        int runTime = (int)max(sliceEnd - currentTime, 0LL);   // 0 if the switch overran an arrival or boost
+        if (!result.fitsClock((long long)currentTime + runTime))
+            return;
+
+        remaining[p] -= runTime;
+        used[p] += runTime;
+        result.ran(table, p, currentTime, currentTime + runTime);
+        currentTime += runTime;
+
+        // Processes arriving during the slice queue up ahead of the preempted one
+        admitArrivals();
+
+        if (remaining[p] == 0) {
+            if (result.endBurst(table, p, currentTime))
+                completed++;
+        }
+        else if (used[p] == quanta[l]) {
+            used[p] = 0;
+            enqueue(p, min(l + 1, levels - 1));   // quantum used up: demote
+        }
+        else {
+            // Interrupted: a process woken at a lower priority does not preempt, so this one resumes first
+            bool preempted = currentTime >= nextBoost || (!queues.empty() && queues.highest() < l);
+            enqueue(p, l, !preempted);
         }
     }
+}
+
+const char* const CFS_TITLE = "Completely Fair Scheduler";
+
+/**
+ * Load weight of each nice value from -20 to 19, as in the Linux scheduler
+ * Every nice step changes the CPU share by about 10% against a nice 0 process.
+ */
+static const int NICE_TO_WEIGHT[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+    9548, 7620, 6100, 4904, 3906,
+    3121, 2501, 1991, 1586, 1277,
+    1024, 820, 655, 526, 423,
+    335, 272, 215, 172, 137,
+    110, 87, 70, 56, 45,
+    36, 29, 23, 18, 15
+};
+static const long long NICE_0_WEIGHT = 1024;
+
+// Virtual runtime is kept in 1/1024 time units so low weights do not round to zero
+static const long long VRUNTIME_SCALE = 1024;
+
+// CFS weight of a process: its priority is used as the nice value (clamped to -20..19)
+static long long cfsWeight(int priority) {
+    return NICE_TO_WEIGHT[min(max(priority, -20), 19) + 20];
+}
 
-    printResults(processes, "Priority Preemptive");
+bool validateCfsOptions(const CfsOptions& options, string& error) {
+    if (options.minGranularity <= 0 || options.targetLatency < options.minGranularity) {
+        error = "CFS needs a positive minimum granularity no larger than the target latency";
+        return false;
+    }
+    return true;
 }
 
 /**
- * Multi-Level Queue Scheduling Algorithm
+ * Completely Fair Scheduler (CFS) Algorithm
  * 
- * Divides processes into multiple queues based on process type:
- * - SYSTEM Queue: Round Robin with time quantum = 2 (highest priority)
- * - INTERACTIVE Queue: Priority Non-Preemptive (medium priority)
- * - BATCH Queue: FCFS (lowest priority)
+ * Every process accumulates virtual runtime: the CPU time it received scaled
+ * by NICE_0_WEIGHT / weight, so higher-weight (lower nice) processes age
+ * more slowly. The process with the smallest virtual runtime runs next.
+ * - Slice: the scheduling period (targetLatency, stretched to
+ *   minGranularity per runnable process when there are many) split in
+ *   proportion to weight, but never shorter than minGranularity.
+ * - Arrivals start at the current minimum virtual runtime, so they neither
+ *   starve nor get credit for the time before they arrived, and preempt the
+ *   running process if it is more than minGranularity (of virtual time)
+ *   ahead of them.
+ * - A process back from I/O keeps its virtual runtime, but is placed no
+ *   further back than half a target latency behind the minimum: a short
+ *   sleep earns a little credit, a long one not a whole backlog.
  * 
- * Queues are served in priority order (SYSTEM > INTERACTIVE > BATCH)
+ * Time only advances to slice ends, completions, arrivals and wakeups, so
+ * the cost depends on the number of slices, not on the time span.
  * 
- * Time Complexity: O(n × q) where n is number of processes, q is time quantum
- * Space Complexity: O(n)
+ * Time Complexity: O((n + s) log n) where s is the number of time slices
+ * Space Complexity: O(n) for the run queue
  * 
- * @param processes Vector of processes to schedule (must be sorted by arrival time)
+ * @param table Processes to schedule (must be sorted by arrival time)
+ * @param result Per-run state and metrics (reset by this function)
+ * @param options Validated target latency and minimum granularity
  */
-void MultiLevelQueue(vector<Process>& processes) {
-    // Ready queues
-    queue<Process*> systemQueue;   // Round Robin
-    priority_queue<Process*, vector<Process*>, PriorityComparator> interactiveQueue;
-    queue<Process*> batchQueue;    // FCFS
+void CompletelyFair(const ProcessTable& table, ScheduleResult& result, const CfsOptions& options) {
+    result.reset(table);
 
+    // Min-heap on (virtual runtime, position in the arrival-sorted table)
+    typedef pair<long long, int> RunQueueEntry;
+    priority_queue<RunQueueEntry, vector<RunQueueEntry>, greater<RunQueueEntry>> runQueue;
+
+    vector<int>& remaining = result.remainingTime;
+    int n = table.size();
     int currentTime = 0;
     int completed = 0;
-    int n = processes.size();
-    int i = 0;
-
-    const int TIME_QUANTUM = 2; // fixed quantum for SYSTEM queue
+    int nextIndex = 0;
 
-    while (completed < n)
+    vector<long long> vruntime(n, 0);
+    long long minVruntime = 0;
+    long long totalWeight = 0;   // of the runnable processes, including the running one
+    long long runnable = 0;
+    const long long wakeupGranularity = (long long)options.minGranularity * VRUNTIME_SCALE;
+    const long long sleeperCredit = (long long)options.targetLatency * VRUNTIME_SCALE / 2;
+
+    int current = -1;
+    long long sliceEnd = 0;
+
+    auto admitArrivals = [&]() {
+        admitReady(table, result, nextIndex, currentTime, [&](int p) {
+            // A process that has run before is waking up from I/O
+            vruntime[p] = result.startTime[p] < 0 ? minVruntime : max(vruntime[p], minVruntime - sleeperCredit);
+            runQueue.push(RunQueueEntry(vruntime[p], p));
+            totalWeight += cfsWeight(table.priority[p]);
+            runnable++;
+        });
+    };
+
+    while (completed < n && !result.clockOverflow)
     {
-        // Add arrived processes to their respective queues
-        while (i < n && processes[i].arrivalTime <= currentTime)
-        {
-            if (processes[i].queueType == SYSTEM)
-                systemQueue.push(&processes[i]);
-            else if (processes[i].queueType == INTERACTIVE)
-                interactiveQueue.push(&processes[i]);
-            else
-                batchQueue.push(&processes[i]);
-
-            i++;
-        }
+        admitArrivals();
 
-        /* ================= SYSTEM QUEUE (Round Robin) ================= */
-        if (!systemQueue.empty())
-        {
-            Process* p = systemQueue.front();
-            systemQueue.pop();
-
-            int execTime = min(TIME_QUANTUM, p->remainingTime);
-            p->remainingTime -= execTime;
-            currentTime += execTime;
-
-            // Add newly arrived processes during execution
-            while (i < n && processes[i].arrivalTime <= currentTime)
-            {
-                if (processes[i].queueType == SYSTEM)
-                    systemQueue.push(&processes[i]);
-                else if (processes[i].queueType == INTERACTIVE)
-                    interactiveQueue.push(&processes[i]);
-                else
-                    batchQueue.push(&processes[i]);
-                i++;
+        if (current < 0) {
+            // CPU idle case: jump to the next arrival or I/O completion
+            if (runQueue.empty()) {
+                currentTime = nextEventTime(table, result, nextIndex);
+                continue;
             }
+            current = runQueue.top().second;
+            runQueue.pop();
+            int overhead = result.dispatch(current);
+            if (!result.fitsClock((long long)currentTime + overhead))
+                return;
+            currentTime += overhead;
+
+            long long weight = cfsWeight(table.priority[current]);
+            long long period = max((long long)options.targetLatency, runnable * options.minGranularity);
+            long long slice = max((long long)options.minGranularity, period * weight / totalWeight);
+            sliceEnd = currentTime + min(slice, (long long)remaining[current]);
+        }
 
-            if (p->remainingTime > 0)
-            {
-                systemQueue.push(p); // not finished ? back to queue
-            }
-            else
-            {
-                p->completionTime = currentTime;
-                p->turnaroundTime = p->completionTime - p->arrivalTime;
-                p->waitingTime = p->turnaroundTime - p->burstTime;
+        // Run until the slice ends or the next arrival or wakeup
+        long long runUntil = sliceEnd;
+        int nextEvent = nextEventTime(table, result, nextIndex);
+        if (nextEvent < runUntil)
+            runUntil = max(nextEvent, currentTime);
+        if (!result.fitsClock(runUntil))
+            return;
+        int runTime = (int)(runUntil - currentTime);
+
+        remaining[current] -= runTime;
+        vruntime[current] += runTime * NICE_0_WEIGHT * VRUNTIME_SCALE / cfsWeight(table.priority[current]);
+        result.ran(table, current, currentTime, currentTime + runTime);
+        currentTime += runTime;
+
+        // The minimum only moves forward
+        long long leftmost = vruntime[current];
+        if (!runQueue.empty())
+            leftmost = min(leftmost, runQueue.top().first);
+        minVruntime = max(minVruntime, leftmost);
+
+        if (remaining[current] == 0) {
+            // Completed or blocked for I/O: either way it leaves the run queue
+            if (result.endBurst(table, current, currentTime))
                 completed++;
-            }
+            totalWeight -= cfsWeight(table.priority[current]);
+            runnable--;
+            current = -1;
         }
-
-        /* ================= INTERACTIVE QUEUE (Priority NP) ================= */
-        else if (!interactiveQueue.empty())
-        {
-            Process* p = interactiveQueue.top();
-            interactiveQueue.pop();
-
-            // Execute process completely (non-preemptive)
-            currentTime += p->remainingTime;
-            p->remainingTime = 0;
-
-            p->completionTime = currentTime;
-            p->turnaroundTime = p->completionTime - p->arrivalTime;
-            p->waitingTime = p->turnaroundTime - p->burstTime;
-
-            completed++;
-
-            // Add newly arrived processes during execution
-            while (i < n && processes[i].arrivalTime <= currentTime)
-            {
-                if (processes[i].queueType == SYSTEM)
-                    systemQueue.push(&processes[i]);
-                else if (processes[i].queueType == INTERACTIVE)
-                    interactiveQueue.push(&processes[i]);
-                else
-                    batchQueue.push(&processes[i]);
-                i++;
-            }
+        else if (currentTime == sliceEnd) {
+            runQueue.push(RunQueueEntry(vruntime[current], current));
+            current = -1;
         }
-
-        /* ================= BATCH QUEUE (FCFS) ================= */
-        else if (!batchQueue.empty())
-        {
-            Process* p = batchQueue.front();
-            batchQueue.pop();
-
-            // Wait if process hasn't arrived yet
-            if (currentTime < p->arrivalTime)
-                currentTime = p->arrivalTime;
-
-            // Execute process completely
-            currentTime += p->remainingTime;
-            p->remainingTime = 0;
-
-            p->completionTime = currentTime;
-            p->turnaroundTime = p->completionTime - p->arrivalTime;
-            p->waitingTime = p->turnaroundTime - p->burstTime;
-
-            completed++;
-
-            // Add newly arrived processes during execution
-            while (i < n && processes[i].arrivalTime <= currentTime)
-            {
-                if (processes[i].queueType == SYSTEM)
-                    systemQueue.push(&processes[i]);
-                else if (processes[i].queueType == INTERACTIVE)
-                    interactiveQueue.push(&processes[i]);
-                else
-                    batchQueue.push(&processes[i]);
-                i++;
+        else {
+            // Interrupted by an arrival or wakeup: the newcomer preempts if the running process is far enough ahead
+            admitArrivals();
+            if (vruntime[current] - runQueue.top().first > wakeupGranularity) {
+                runQueue.push(RunQueueEntry(vruntime[current], current));
+                current = -1;
             }
         }
+    }
+}
 
-        /* ================= CPU IDLE ================= */
-        else
-        {
-            // No process in any queue - jump to next arrival time
-            if (i < n) {
-                currentTime = processes[i].arrivalTime;
-            } else {
-                // All processes have arrived but not completed (shouldn't happen)
-                currentTime++;
-            }
-        }
+/**
+ * Runs the table-based algorithm with the given menu number
+ *
+ * @param algoChoice Menu number of the algorithm (1-7, see ALGORITHM_TITLES)
+ * @param timeQuantum Time quantum, only used by Round Robin (at least 1)
+ * @return false if algoChoice is not a valid menu number, or for Round Robin
+ *         with a quantum below 1 (nothing is run)
+ */
+bool runAlgorithm(int algoChoice, const ProcessTable& table, ScheduleResult& result, int timeQuantum)
+{
+    if (algoChoice == 4 && timeQuantum < 1)
+        return false;
+    switch (algoChoice) {
+    case 1: FCFS(table, result); return true;
+    case 2: SJF_NonPreemptive(table, result); return true;
+    case 3: Priority_NonPreemptive(table, result); return true;
+    case 4: RoundRobin(table, result, timeQuantum); return true;
+    case 5: SJF_Preemptive(table, result); return true;
+    case 6: Priority_Preemptive(table, result); return true;
+    case 7: MultiLevelQueue(table, result); return true;
+    default: return false;
     }
+}
+
+/*
+ * vector<Process> adapters
+ * Each one builds a ProcessTable, runs the table version and copies the
+ * metrics back into the Process objects. Reporting is up to the caller
+ * (see printResults and ResultSink).
+ */
 
-    printResults(processes, "Multi-Level Queue");
-}
\ No newline at end of file
+/**
+ * Runs a table-based algorithm on a Process vector
+ * 
+ * @param processes Vector of processes to schedule (must be sorted by arrival time)
+ * @param run Callable taking (const ProcessTable&, ScheduleResult&)
+ */
+template <typename Algorithm>
+static void runOnProcesses(vector<Process>& processes, Algorithm run)
+{
+    ProcessTable table(processes);
+    ScheduleResult result;
+    run(table, result);
+    result.writeTo(processes);
+}
+
+void FCFS(vector<Process>& processes)
+{
+    runOnProcesses(processes, [](const ProcessTable& t, ScheduleResult& r) { FCFS(t, r); });
+}
+
+void SJF_NonPreemptive(vector<Process>& processes)
+{
+    runOnProcesses(processes, [](const ProcessTable& t, ScheduleResult& r) { SJF_NonPreemptive(t, r); });
+}
+
+void Priority_NonPreemptive(vector<Process>& processes)
+{
+    runOnProcesses(processes, [](const ProcessTable& t, ScheduleResult& r) { Priority_NonPreemptive(t, r); });
+}
+
+void RoundRobin(vector<Process>& processes, int timeQuantum)
+{
+    runOnProcesses(processes, [timeQuantum](const ProcessTable& t, ScheduleResult& r) { RoundRobin(t, r, timeQuantum); });
+}
+
+void SJF_Preemptive(vector<Process>& processes)
+{
+    runOnProcesses(processes, [](const ProcessTable& t, ScheduleResult& r) { SJF_Preemptive(t, r); });
+}
+
+void Priority_Preemptive(vector<Process>& processes)
+{
+    runOnProcesses(processes, [](const ProcessTable& t, ScheduleResult& r) { Priority_Preemptive(t, r); });
+}
+
+void MultiLevelQueue(vector<Process>& processes)
+{
+    runOnProcesses(processes, [](const ProcessTable& t, ScheduleResult& r) { MultiLevelQueue(t, r); });
+}
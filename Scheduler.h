@@ -1,8 +1,54 @@
 #pragma once
 
 #include "Process.h"
+#include "ProcessTable.h"
 #include <vector>
+#include <string>
 
+// Table-based algorithms: input must be sorted by arrival time, metrics go to result
+void FCFS(const ProcessTable& table, ScheduleResult& result);
+void SJF_NonPreemptive(const ProcessTable& table, ScheduleResult& result);
+void Priority_NonPreemptive(const ProcessTable& table, ScheduleResult& result);
+void RoundRobin(const ProcessTable& table, ScheduleResult& result, int timeQuantum);
+void SJF_Preemptive(const ProcessTable& table, ScheduleResult& result);
+void Priority_Preemptive(const ProcessTable& table, ScheduleResult& result);
+void MultiLevelQueue(const ProcessTable& table, ScheduleResult& result);
+
+// Most levels a Multi-Level Feedback Queue can have
+const int MLFQ_MAX_LEVELS = 4096;
+
+/**
+ * Parameters of the Multi-Level Feedback Queue
+ */
+struct MlfqOptions {
+    std::vector<int> quanta = { 2, 4, 8 };   // time quantum of each level, highest priority first
+    int boostInterval = 0;    // all processes return to level 0 every boostInterval time units (0 = never)
+    int agingThreshold = 0;   // a process waiting this long in a queue moves one level up (0 = never)
+};
+
+// Checks the level count, quanta, boost interval and aging threshold; false (with error set) if invalid
+bool validateMlfqOptions(const MlfqOptions& options, std::string& error);
+
+void MultiLevelFeedbackQueue(const ProcessTable& table, ScheduleResult& result, const MlfqOptions& options);
+
+/**
+ * Parameters of the Completely Fair Scheduler
+ * A process's priority is its nice value (-20..19, lower gets more CPU).
+ */
+struct CfsOptions {
+    int targetLatency = 24;    // period in which every runnable process should run once
+    int minGranularity = 3;    // shortest slice; also the virtual-time lead that lets an arrival preempt
+};
+
+// Checks the latency and granularity; false (with error set) if invalid
+bool validateCfsOptions(const CfsOptions& options, std::string& error);
+
+void CompletelyFair(const ProcessTable& table, ScheduleResult& result, const CfsOptions& options);
+
+// Runs the table-based algorithm with menu number 1-7; false if the number (or the Round Robin quantum) is invalid
+bool runAlgorithm(int algoChoice, const ProcessTable& table, ScheduleResult& result, int timeQuantum);
+
+// vector<Process> adapters: run the table version and store the metrics in the processes
 void FCFS(std::vector<Process>& processes);
 void SJF_NonPreemptive(std::vector<Process>& processes);
 void Priority_NonPreemptive(std::vector<Process>& processes);
@@ -11,4 +57,7 @@ void SJF_Preemptive(std::vector<Process>& processes);
 void Priority_Preemptive(std::vector<Process>& processes);
 void MultiLevelQueue(std::vector<Process>& processes);
 
-
+// Display title of each algorithm, indexed by menu number - 1
+extern const char* const ALGORITHM_TITLES[7];
+extern const char* const MLFQ_TITLE;
+extern const char* const CFS_TITLE;
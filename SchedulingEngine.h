@@ -0,0 +1,252 @@
+#pragma once
+#include <vector>
+#include <climits>
+#include <algorithm>
+#include "ProcessTable.h"
+#include "Checkpoint.h"
+
+/*
+ * Single-CPU simulation loop shared by the table-based algorithms
+ *
+ * An algorithm is a policy type plugged into runPolicy at compile time, so
+ * the ready structure, slice length and preemption rule are inlined into the
+ * loop: there is no virtual call per scheduling decision. A policy provides
+ *
+ *   static const bool PREEMPTIVE;   // cut slices at the next arrival or wakeup
+ *   bool empty() const;             // no process is ready
+ *   void push(int i);               // process i became ready (arrival, wakeup or preempted)
+ *   int pop();                      // next process to dispatch
+ *   int quantum(int i) const;       // longest slice for process i (INT_MAX: whole CPU burst)
+ *   void beforeDispatch(const ProcessTable&, ScheduleResult&, int& currentTime, int nextIndex);
+ *   void save(CheckpointWriter&) const;                 // ready structures and policy state
+ *   bool load(const ProcessTable&, CheckpointReader&);  // what save wrote; false if invalid
+ *
+ * and can inherit PolicyDefaults for the hooks it does not need. The loop
+ * itself handles arrivals, I/O wakeups, idle gaps, switching costs, the
+ * timeline, checkpoints and the final metrics (through ScheduleResult).
+ */
+
+/**
+ * Moves the processes that arrived, or finished their I/O, by currentTime to
+ * a ready structure, in time order (an arrival first on a tie)
+ *
+ * @param nextIndex Cursor over the arrival-sorted table, advanced past the arrivals
+ * @param enqueue Called with the table index of every process that became ready
+ */
+template <typename Enqueue>
+inline void admitReady(const ProcessTable& table, ScheduleResult& result, int& nextIndex, int currentTime, Enqueue enqueue)
+{
+    const std::vector<int>& arrival = table.arrivalTime;
+    int n = table.size();
+    if (result.blocked.empty()) {
+        while (nextIndex < n && arrival[nextIndex] <= currentTime)
+            enqueue(nextIndex++);
+        return;
+    }
+    while (true) {
+        int wakeup = result.nextWakeup();
+        if (nextIndex < n && arrival[nextIndex] <= currentTime && arrival[nextIndex] <= wakeup)
+            enqueue(nextIndex++);
+        else if (wakeup <= currentTime)
+            result.wakeUp(wakeup, enqueue);   // everything finishing I/O at that instant
+        else
+            break;
+    }
+}
+
+// Time of the next arrival or I/O completion, INT_MAX if neither is left
+inline int nextEventTime(const ProcessTable& table, const ScheduleResult& result, int nextIndex) {
+    int nextArrival = nextIndex < (int)table.size() ? table.arrivalTime[nextIndex] : INT_MAX;
+    return std::min(nextArrival, result.nextWakeup());
+}
+
+// No-op hooks and run-to-completion slices, for policies to inherit
+struct PolicyDefaults {
+    static const bool PREEMPTIVE = false;
+
+    int quantum(int /*i*/) const { return INT_MAX; }
+
+    // Called with a non-empty ready structure before every dispatch
+    void beforeDispatch(const ProcessTable& /*table*/, ScheduleResult& /*result*/, int& /*currentTime*/, int /*nextIndex*/) {}
+};
+
+/* ================= CHECKPOINTS (see Checkpoint.h) ================= */
+
+inline void saveQueue(const IndexRing& queue, CheckpointWriter& state) {
+    std::vector<int> items(queue.size());
+    for (size_t k = 0; k < items.size(); k++)
+        items[k] = queue[k];
+    state.putVector(items);
+}
+
+inline bool loadQueue(const ProcessTable& table, CheckpointReader& state, IndexRing& queue) {
+    std::vector<int> items;
+    if (!state.getVector(items, table.size()))
+        return false;
+    queue.reset(table.size());
+    for (int i : items) {
+        if (i < 0 || i >= (int)table.size())
+            return false;
+        queue.push_back(i);
+    }
+    return true;
+}
+
+inline void saveQueue(const KeyedHeap& heap, CheckpointWriter& state) {
+    state.putVector(heap.contents());
+}
+
+inline bool loadQueue(const ProcessTable& table, CheckpointReader& state, KeyedHeap& heap) {
+    std::vector<HeapEntry> entries;
+    if (!state.getVector(entries, table.size()))
+        return false;
+    for (const HeapEntry& entry : entries) {
+        if (entry.index < 0 || entry.index >= (int)table.size())
+            return false;
+    }
+    heap.assign(entries);
+    return true;
+}
+
+// Flattened (bucket, process) pairs, in pop order within each bucket
+inline void saveQueue(const BucketQueue& buckets, CheckpointWriter& state) {
+    std::vector<int> items;
+    buckets.forEach([&items](int bucket, int i) {
+        items.push_back(bucket);
+        items.push_back(i);
+    });
+    state.putVector(items);
+}
+
+// The queue must already be reset to the bucket count of the saved run
+inline bool loadQueue(const ProcessTable& table, CheckpointReader& state, BucketQueue& buckets) {
+    std::vector<int> items;
+    if (!state.getVector(items, 2 * table.size()) || items.size() % 2 != 0)
+        return false;
+    for (size_t k = 0; k < items.size(); k += 2) {
+        int bucket = items[k], i = items[k + 1];
+        if (bucket < 0 || bucket >= buckets.bucketCount() || i < 0 || i >= (int)table.size())
+            return false;
+        buckets.push(bucket, i);
+    }
+    return true;
+}
+
+// Writes the loop variables, the result and the policy state to result.checkpoints
+template <typename Policy>
+bool writeCheckpoint(const ProcessTable& table, const ScheduleResult& result, const Policy& policy,
+    int currentTime, int completed, int nextIndex)
+{
+    CheckpointWriter state;
+    state.put(currentTime);
+    state.put(completed);
+    state.put(nextIndex);
+    saveResultState(result, state);
+    policy.save(state);
+    return result.checkpoints->write(table, currentTime, state);
+}
+
+// Restores what writeCheckpoint wrote from result.checkpoints's resume file
+template <typename Policy>
+bool resumeFromCheckpoint(const ProcessTable& table, ScheduleResult& result, Policy& policy,
+    int& currentTime, int& completed, int& nextIndex)
+{
+    RunCheckpoints& checkpoints = *result.checkpoints;
+    CheckpointReader state;
+    if (!checkpoints.read(table, state))
+        return false;
+    int n = table.size();
+    bool ok = state.get(currentTime) && state.get(completed) && state.get(nextIndex)
+        && completed >= 0 && completed <= n && nextIndex >= 0 && nextIndex <= n
+        && loadResultState(table, state, result) && policy.load(table, state) && state.atEnd();
+    if (!ok) {
+        checkpoints.fail("the checkpoint does not hold a valid state of this run");
+        return false;
+    }
+    checkpoints.resumedAt(currentTime);
+    return true;
+}
+
+/**
+ * Runs the workload under a scheduling policy
+ *
+ * Every iteration admits the processes that became ready, dispatches the
+ * one the policy picks and runs it for its quantum, or until its CPU burst
+ * ends, or (PREEMPTIVE policies) until the next arrival or wakeup. A process
+ * with CPU time left is pushed back after the processes that arrived during
+ * its slice. Idle gaps are skipped in one step.
+ *
+ * With result.checkpoints set, the run can start from a checkpoint and writes
+ * one whenever the configured simulated time has passed, between two slices.
+ * A run that fails to read or write a checkpoint stops there, with the error
+ * in result.checkpoints.
+ *
+ * Time Complexity: O(s × c) where s is the number of slices and c the cost
+ *                  of one push and pop of the policy
+ *
+ * @param table Processes to schedule (must be sorted by arrival time)
+ * @param result Per-run state and metrics (reset by this function)
+ * @param policy Ready structure and rules of the algorithm
+ */
+template <typename Policy>
+void runPolicy(const ProcessTable& table, ScheduleResult& result, Policy& policy)
+{
+    result.reset(table);
+
+    std::vector<int>& remaining = result.remainingTime;
+    int n = table.size();
+    int currentTime = 0;
+    int completed = 0;
+    int nextIndex = 0;
+    auto push = [&policy](int i) { policy.push(i); };
+
+    RunCheckpoints* checkpoints = result.checkpoints;
+    if (checkpoints && checkpoints->resuming()
+        && !resumeFromCheckpoint(table, result, policy, currentTime, completed, nextIndex))
+        return;
+
+    while (completed < n && !result.clockOverflow)
+    {
+        if (checkpoints && checkpoints->due(currentTime)
+            && !writeCheckpoint(table, result, policy, currentTime, completed, nextIndex))
+            return;
+
+        admitReady(table, result, nextIndex, currentTime, push);
+
+        // CPU idle case: jump to the next arrival or I/O completion
+        if (policy.empty()) {
+            currentTime = nextEventTime(table, result, nextIndex);
+            continue;
+        }
+
+        policy.beforeDispatch(table, result, currentTime, nextIndex);
+        int p = policy.pop();
+        int overhead = result.dispatch(p);
+        if (!result.fitsClock((long long)currentTime + overhead))
+            return;
+        currentTime += overhead;
+
+        // Run for the quantum or the rest of the CPU burst; a preemptive policy
+        // stops at the next arrival or wakeup (at once if it came during the switch)
+        int runTime = std::min(remaining[p], policy.quantum(p));
+        if (Policy::PREEMPTIVE) {
+            int nextEvent = nextEventTime(table, result, nextIndex);
+            if (nextEvent - currentTime < runTime)
+                runTime = std::max(nextEvent - currentTime, 0);
+        }
+        if (!result.fitsClock((long long)currentTime + runTime))
+            return;
+        remaining[p] -= runTime;
+        result.ran(table, p, currentTime, currentTime + runTime);
+        currentTime += runTime;
+
+        if (remaining[p] > 0) {
+            // Processes arriving during the slice queue up ahead of the preempted one
+            admitReady(table, result, nextIndex, currentTime, push);
+            policy.push(p);
+        }
+        else if (result.endBurst(table, p, currentTime)) {
+            completed++;
+        }
+    }
+}
@@ -0,0 +1,399 @@
+#include "Smp.h"
+#include "Scheduler.h"
+#include "WorkloadGenerator.h"
+#include <algorithm>
+#include <queue>
+#include <functional>
+#include <climits>
+
+using namespace std;
+
+const char* const SMP_QUEUE_MODE_NAMES[3] = { "global", "per-cpu", "work-stealing" };
+
+// Run queue entry: table index and the order it was queued in
+struct SmpEntry {
+    int index;
+    long long order;
+};
+
+/*
+ * Run queue orderings, written as "a runs after b" for the heap functions
+ */
+
+// FCFS and Round Robin: queue order
+struct FifoOrder {
+    const ProcessTable* table;
+
+    bool operator()(const SmpEntry& a, const SmpEntry& b) const {
+        return a.order > b.order;
+    }
+};
+
+// SJF: shorter burst, then earlier arrival, like SJFKey in Scheduler.cpp; full
+// ties are left to the heap, so one CPU runs them in the order SJF does
+struct ShortestJobOrder {
+    const ProcessTable* table;
+
+    bool operator()(const SmpEntry& a, const SmpEntry& b) const {
+        const vector<int>& burst = table->burstTime;
+        if (burst[a.index] != burst[b.index])
+            return burst[a.index] > burst[b.index];
+        return table->arrivalTime[a.index] > table->arrivalTime[b.index];
+    }
+};
+
+// Priority: lower priority value, then earlier arrival, then smaller PID
+struct PriorityOrder {
+    const ProcessTable* table;
+
+    bool operator()(const SmpEntry& a, const SmpEntry& b) const {
+        const vector<int>& priority = table->priority;
+        if (priority[a.index] != priority[b.index])
+            return priority[a.index] > priority[b.index];
+        if (table->arrivalTime[a.index] != table->arrivalTime[b.index])
+            return table->arrivalTime[a.index] > table->arrivalTime[b.index];
+        return table->pid[a.index] > table->pid[b.index];
+    }
+};
+
+/**
+ * Number of processes on each CPU (queued + running) with O(1) max - min
+ * Loads only change by one at a time, so a count of CPUs per load value lets
+ * the highest and lowest load move by at most one step per update.
+ */
+class LoadTracker {
+public:
+    explicit LoadTracker(int cpuCount) : load(cpuCount, 0), cpusAtLoad(1, cpuCount) {}
+
+    int operator[](int cpu) const { return load[cpu]; }
+    int imbalance() const { return highest - lowest; }
+
+    // Adds delta (+1 or -1) to the load of cpu
+    void add(int cpu, int delta) {
+        int before = load[cpu];
+        int after = before + delta;
+        load[cpu] = after;
+        if ((size_t)after >= cpusAtLoad.size())
+            cpusAtLoad.push_back(0);
+        cpusAtLoad[before]--;
+        cpusAtLoad[after]++;
+
+        highest = max(highest, after);
+        lowest = min(lowest, after);
+        if (cpusAtLoad[highest] == 0)
+            highest--;
+        if (cpusAtLoad[lowest] == 0)
+            lowest++;
+    }
+
+private:
+    vector<int> load;
+    vector<int> cpusAtLoad;
+    int highest = 0;
+    int lowest = 0;
+};
+
+/**
+ * Set of idle CPUs with O(1) insert and removal
+ */
+class IdleSet {
+public:
+    explicit IdleSet(int cpuCount) : position(cpuCount) {
+        for (int cpu = 0; cpu < cpuCount; cpu++)
+            insert(cpu);
+    }
+
+    bool empty() const { return cpus.empty(); }
+    bool contains(int cpu) const { return position[cpu] >= 0; }
+    const vector<int>& members() const { return cpus; }
+
+    void insert(int cpu) {
+        position[cpu] = (int)cpus.size();
+        cpus.push_back(cpu);
+    }
+
+    void erase(int cpu) {
+        int last = cpus.back();
+        cpus[position[cpu]] = last;
+        position[last] = position[cpu];
+        cpus.pop_back();
+        position[cpu] = -1;
+    }
+
+private:
+    vector<int> cpus;
+    vector<int> position;   // index in cpus, -1 if busy
+};
+
+/**
+ * The multi-CPU event loop for one run queue ordering
+ */
+template <typename Order>
+class SmpSimulation {
+public:
+    SmpSimulation(const ProcessTable& table, const SmpOptions& options, ScheduleResult& result, SmpStats& stats)
+        : table(table), options(options), result(result), stats(stats),
+          cpuCount(options.cpuCount), global(options.queueMode == GLOBAL_QUEUE),
+          queues(global ? 1 : options.cpuCount),
+          running(options.cpuCount, -1), lastProcess(options.cpuCount, -1), lastCpu(table.size(), -1),
+          loads(options.cpuCount), idle(options.cpuCount) {
+        rng.state = options.seed;
+        order.table = &table;
+    }
+
+    void run();
+
+private:
+    typedef vector<SmpEntry> RunQueue;   // heap ordered by Order
+    typedef pair<int, int> SliceEnd;     // end time, CPU
+
+    RunQueue& queueOf(int cpu) { return queues[global ? 0 : cpu]; }
+    int randomCpu() { return (int)(rng.next() % (uint64_t)cpuCount); }
+
+    void enqueue(int cpu, int p);
+    int dequeue(int cpu);
+    void place(int p);
+    int findVictim(int thief);
+    void start(int cpu, int p, int currentTime);
+    void dispatchIdle(int currentTime);
+
+    const ProcessTable& table;
+    const SmpOptions& options;
+    ScheduleResult& result;
+    SmpStats& stats;
+    int cpuCount;
+    bool global;
+    Order order;
+
+    vector<RunQueue> queues;
+    size_t queuedTotal = 0;
+    long long queueOrder = 0;
+    vector<int> running;        // process on each CPU, -1 if idle
+    vector<int> lastProcess;    // last process each CPU ran
+    vector<int> lastCpu;        // last CPU each process ran on
+    priority_queue<SliceEnd, vector<SliceEnd>, greater<SliceEnd>> sliceEnds;
+    LoadTracker loads;
+    IdleSet idle;
+    vector<int> woken;          // CPUs to check for work in their own queue
+    SplitMix64 rng;
+};
+
+template <typename Order>
+void SmpSimulation<Order>::enqueue(int cpu, int p) {
+    RunQueue& queue = queueOf(cpu);
+    SmpEntry entry = { p, queueOrder++ };
+    queue.push_back(entry);
+    push_heap(queue.begin(), queue.end(), order);
+    queuedTotal++;
+    if (!global) {
+        loads.add(cpu, +1);
+        if (idle.contains(cpu))
+            woken.push_back(cpu);
+    }
+    CpuStats& cpuStats = stats.cpus[global ? 0 : cpu];
+    cpuStats.peakQueue = max(cpuStats.peakQueue, queue.size());
+}
+
+template <typename Order>
+int SmpSimulation<Order>::dequeue(int cpu) {
+    RunQueue& queue = queueOf(cpu);
+    pop_heap(queue.begin(), queue.end(), order);
+    int p = queue.back().index;
+    queue.pop_back();
+    queuedTotal--;
+    if (!global)
+        loads.add(cpu, -1);
+    return p;
+}
+
+// Queues an arriving process: shared queue, or the less loaded of two random CPUs
+template <typename Order>
+void SmpSimulation<Order>::place(int p) {
+    if (global) {
+        enqueue(0, p);
+        return;
+    }
+    int a = randomCpu();
+    int b = randomCpu();
+    enqueue(loads[b] < loads[a] ? b : a, p);
+}
+
+// CPU to steal from: the longer queue of two random CPUs, else the first CPU with work
+template <typename Order>
+int SmpSimulation<Order>::findVictim(int thief) {
+    int a = randomCpu();
+    int b = randomCpu();
+    int victim = queues[b].size() > queues[a].size() ? b : a;
+    if (victim != thief && !queues[victim].empty())
+        return victim;
+
+    int from = randomCpu();
+    for (int k = 0; k < cpuCount; k++) {
+        int cpu = (from + k) % cpuCount;
+        if (cpu != thief && !queues[cpu].empty())
+            return cpu;
+    }
+    return -1;
+}
+
+// Gives p the CPU until its slice ends
+template <typename Order>
+void SmpSimulation<Order>::start(int cpu, int p, int currentTime) {
+    CpuStats& cpuStats = stats.cpus[cpu];
+    cpuStats.dispatches++;
+    if (lastProcess[cpu] != p && lastProcess[cpu] != -1)
+        cpuStats.contextSwitches++;
+    if (lastCpu[p] != cpu && lastCpu[p] != -1)
+        cpuStats.migrations++;
+    lastProcess[cpu] = p;
+    lastCpu[p] = cpu;
+    if (result.startTime[p] < 0)
+        result.startTime[p] = currentTime;
+
+    int& remaining = result.remainingTime[p];
+    int slice = options.algorithm == 4 ? min(remaining, options.timeQuantum) : remaining;
+    remaining -= slice;
+    cpuStats.busyTime += slice;
+
+    running[cpu] = p;
+    idle.erase(cpu);
+    loads.add(cpu, +1);
+    sliceEnds.push(SliceEnd(currentTime + slice, cpu));
+}
+
+template <typename Order>
+void SmpSimulation<Order>::dispatchIdle(int currentTime) {
+    if (global) {
+        woken.clear();
+        while (queuedTotal > 0 && !idle.empty())
+            start(idle.members().back(), dequeue(0), currentTime);
+        return;
+    }
+
+    // CPUs that became idle or got work run their own queue first
+    for (int cpu : woken) {
+        if (idle.contains(cpu) && !queues[cpu].empty())
+            start(cpu, dequeue(cpu), currentTime);
+    }
+    woken.clear();
+
+    if (options.queueMode != WORK_STEALING)
+        return;
+    while (queuedTotal > 0 && !idle.empty()) {
+        int thief = idle.members().back();
+        int victim = findVictim(thief);
+        if (victim < 0)
+            break;
+        stats.cpus[thief].steals++;
+        start(thief, dequeue(victim), currentTime);
+    }
+}
+
+template <typename Order>
+void SmpSimulation<Order>::run() {
+    const vector<int>& arrival = table.arrivalTime;
+    int n = table.size();
+    int completed = 0;
+    int nextIndex = 0;
+    int currentTime = 0;
+    double imbalanceArea = 0.0;
+
+    while (completed < n) {
+        // Next event: an arrival or the end of a running slice
+        int eventTime = INT_MAX;
+        if (!sliceEnds.empty())
+            eventTime = sliceEnds.top().first;
+        if (nextIndex < n)
+            eventTime = min(eventTime, arrival[nextIndex]);
+
+        imbalanceArea += (double)loads.imbalance() * (eventTime - currentTime);
+        currentTime = eventTime;
+
+        // Arrivals queue up ahead of processes preempted at the same time, as in RoundRobin
+        while (nextIndex < n && arrival[nextIndex] <= currentTime)
+            place(nextIndex++);
+
+        while (!sliceEnds.empty() && sliceEnds.top().first == currentTime) {
+            int cpu = sliceEnds.top().second;
+            sliceEnds.pop();
+            int p = running[cpu];
+            running[cpu] = -1;
+            loads.add(cpu, -1);
+            idle.insert(cpu);
+            woken.push_back(cpu);
+
+            if (result.remainingTime[p] == 0) {
+                result.complete(table, p, currentTime);
+                completed++;
+            }
+            else {
+                enqueue(cpu, p);
+            }
+        }
+
+        dispatchIdle(currentTime);
+        stats.peakImbalance = max(stats.peakImbalance, loads.imbalance());
+    }
+
+    stats.makespan = currentTime;
+    if (currentTime > 0)
+        stats.averageImbalance = imbalanceArea / currentTime;
+}
+
+bool validateSmpOptions(const SmpOptions& options, string& error) {
+    if (options.cpuCount < 1) {
+        error = "CPU count must be a positive integer";
+        return false;
+    }
+    if (options.algorithm < 1 || options.algorithm > 4) {
+        error = "Multi-CPU runs support fcfs, sjf, priority and rr";
+        return false;
+    }
+    if (options.timeQuantum < 1) {
+        error = "Time quantum must be a positive integer";
+        return false;
+    }
+    return true;
+}
+
+void runSmp(const ProcessTable& table, const SmpOptions& options, ScheduleResult& result, SmpStats& stats) {
+    result.reset(table);
+    result.cpuCount = options.cpuCount;
+    stats = SmpStats();
+    stats.queueMode = options.queueMode;
+    stats.cpus.assign(options.cpuCount, CpuStats());
+
+    switch (options.algorithm) {
+    case 2: SmpSimulation<ShortestJobOrder>(table, options, result, stats).run(); break;
+    case 3: SmpSimulation<PriorityOrder>(table, options, result, stats).run(); break;
+    default: SmpSimulation<FifoOrder>(table, options, result, stats).run(); break;
+    }
+
+    for (const CpuStats& cpu : stats.cpus) {
+        result.contextSwitches += cpu.contextSwitches;
+        stats.migrations += cpu.migrations;
+        stats.steals += cpu.steals;
+    }
+}
+
+string smpTitle(const SmpOptions& options) {
+    return string(ALGORITHM_TITLES[options.algorithm - 1]) + " (" + to_string(options.cpuCount)
+        + (options.cpuCount == 1 ? " CPU, " : " CPUs, ") + SMP_QUEUE_MODE_NAMES[options.queueMode] + ")";
+}
+
+void printSmpStats(const SmpStats& stats, FILE* out) {
+    fprintf(out, "\n  CPU Statistics (%zu CPUs, %s queues, makespan %d)\n\n",
+        stats.cpus.size(), SMP_QUEUE_MODE_NAMES[stats.queueMode], stats.makespan);
+    fprintf(out, "  %5s %14s %7s %12s %12s %12s %12s %10s\n",
+        "CPU", "Busy", "Util %", "Dispatches", "Switches", "Migrations", "Steals", "Peak queue");
+    fprintf(out, "  %s\n", string(5 + 15 + 8 + 13 * 4 + 11, '-').c_str());
+    for (size_t i = 0; i < stats.cpus.size(); i++) {
+        const CpuStats& c = stats.cpus[i];
+        double utilization = stats.makespan > 0 ? 100.0 * c.busyTime / stats.makespan : 0.0;
+        fprintf(out, "  %5zu %14lld %7.2f %12lld %12lld %12lld %12lld %10zu\n",
+            i, c.busyTime, utilization, c.dispatches, c.contextSwitches, c.migrations, c.steals, c.peakQueue);
+    }
+    fprintf(out, "\n  Migrations: %lld  Steals: %lld  Queue imbalance (max - min load): average %.2f, peak %d\n\n",
+        stats.migrations, stats.steals, stats.averageImbalance, stats.peakImbalance);
+    fflush(out);
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include "ProcessTable.h"
+
+enum SmpQueueMode {
+    GLOBAL_QUEUE,     // one run queue shared by every CPU
+    PER_CPU_QUEUES,   // arrivals are placed on a CPU and stay on it
+    WORK_STEALING     // per-CPU queues; an idle CPU takes work from a loaded one
+};
+
+// Batch mode names of the queue modes, indexed by SmpQueueMode
+extern const char* const SMP_QUEUE_MODE_NAMES[3];
+
+/**
+ * Parameters of a multi-CPU run
+ */
+struct SmpOptions {
+    int cpuCount = 4;
+    SmpQueueMode queueMode = WORK_STEALING;
+    int algorithm = 1;        // menu number: 1 FCFS, 2 SJF, 3 Priority, 4 Round Robin
+    int timeQuantum = 2;      // Round Robin only
+    uint64_t seed = 1;        // placement and steal victim choices
+};
+
+// What one CPU did during a run
+struct CpuStats {
+    long long busyTime = 0;
+    long long dispatches = 0;
+    long long contextSwitches = 0;
+    long long migrations = 0;   // dispatches of a process that last ran on another CPU
+    long long steals = 0;       // processes taken from another CPU's queue
+    size_t peakQueue = 0;       // longest own run queue (GLOBAL_QUEUE: the shared queue, on CPU 0)
+};
+
+// Per-CPU and machine-wide statistics of a multi-CPU run
+struct SmpStats {
+    SmpQueueMode queueMode = WORK_STEALING;
+    std::vector<CpuStats> cpus;
+    int makespan = 0;
+    long long migrations = 0;
+    long long steals = 0;
+    double averageImbalance = 0.0;   // time-weighted max - min CPU load (queued + running)
+    int peakImbalance = 0;
+};
+
+/**
+ * Checks that the options describe a supported run
+ *
+ * @return false (with error set) on a bad parameter
+ */
+bool validateSmpOptions(const SmpOptions& options, std::string& error);
+
+/**
+ * Simulates the workload on several CPUs
+ *
+ * Event-driven: time jumps to the next arrival or to the earliest end of a
+ * running slice (kept in a heap keyed by CPU), so a run costs
+ * O((n + s) log(n + c)) for n processes, s slices and c CPUs, whatever the
+ * time span.
+ *
+ * Arrivals are placed on the less loaded of two randomly chosen CPUs (per-CPU
+ * modes). A preempted Round Robin process goes back to the queue of the CPU
+ * it ran on. With WORK_STEALING, a CPU whose own queue is empty takes the best
+ * waiting process of the more loaded of two random CPUs, or of the first CPU
+ * with work if both are empty.
+ *
+ * The per-process metrics go to result as for the single-CPU algorithms
+ * (result.contextSwitches is the sum over the CPUs); the timeline is not
+ * recorded. I/O bursts are not modeled: the table must not have any.
+ *
+ * @param table Processes to schedule (must be sorted by arrival time)
+ * @param options Validated run parameters
+ * @param result Per-run state and metrics (reset by this function)
+ * @param stats Receives the per-CPU statistics
+ */
+void runSmp(const ProcessTable& table, const SmpOptions& options, ScheduleResult& result, SmpStats& stats);
+
+// Title of a run, e.g. "Round Robin (8 CPUs, work-stealing)"
+std::string smpTitle(const SmpOptions& options);
+
+// Writes the per-CPU utilization, migrations and queue imbalance as a text table
+void printSmpStats(const SmpStats& stats, FILE* out);
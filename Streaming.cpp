@@ -0,0 +1,354 @@
+#include "Streaming.h"
+#include "Scheduler.h"
+#include <algorithm>
+#include <queue>
+#include <deque>
+#include <climits>
+
+using namespace std;
+
+bool ProcessSource::fitsClock(const Process& process) {
+    pulledArrival = max(pulledArrival, (long long)process.arrivalTime);
+    pulledWork += process.burstTime;
+    return pulledArrival + pulledWork <= INT_MAX;
+}
+
+bool VectorProcessSource::next(Process& process) {
+    if (index == processes.size())
+        return false;
+    process = processes[index++];
+    return true;
+}
+
+bool MappedProcessSource::next(Process& process) {
+    if (!errorMessage.empty() || index == workload.size())
+        return false;
+    if (!workload.checkRecord(index, errorMessage))
+        return false;
+    process = workload[index++].toProcess();
+    if (!fitsClock(process)) {
+        errorMessage = CLOCK_OVERFLOW_ERROR;
+        return false;
+    }
+    return true;
+}
+
+bool TextProcessSource::next(Process& process) {
+    if (!errorMessage.empty() || !reader.next(process))
+        return false;
+    if (process.arrivalTime < lastArrival) {
+        errorMessage = "text workload is not sorted by arrival time (pid " + to_string(process.pid) + ")";
+        return false;
+    }
+    if (!process.bursts.empty()) {
+        errorMessage = "streaming mode does not model I/O bursts (pid " + to_string(process.pid) + ")";
+        return false;
+    }
+    if (!fitsClock(process)) {
+        errorMessage = CLOCK_OVERFLOW_ERROR;
+        return false;
+    }
+    lastArrival = process.arrivalTime;
+    return true;
+}
+
+/**
+ * One-process lookahead over a ProcessSource
+ * Lets the schedulers ask for the next arrival time without consuming it.
+ */
+class ArrivalStream {
+public:
+    explicit ArrivalStream(ProcessSource& source) : source(source), pending(0, 0, 0, 0, BATCH) {
+        hasPending = source.next(pending);
+    }
+
+    bool empty() const { return !hasPending; }
+    int nextArrival() const { return pending.arrivalTime; }
+    bool arrivedBy(int currentTime) const { return hasPending && pending.arrivalTime <= currentTime; }
+
+    Process take() {
+        Process process = pending;
+        hasPending = source.next(pending);
+        return process;
+    }
+
+private:
+    ProcessSource& source;
+    Process pending;
+    bool hasPending;
+};
+
+/**
+ * Calculates the final metrics of a process, hands it to the sink and
+ * folds it into the running aggregates
+ */
+static void finishProcess(Process& p, int currentTime, ResultSink& sink, StreamSummary& summary) {
+    p.remainingTime = 0;
+    p.completionTime = currentTime;
+    p.turnaroundTime = p.completionTime - p.arrivalTime;
+    p.waitingTime = p.turnaroundTime - p.burstTime;
+    p.responseTime = p.startTime - p.arrivalTime;
+    sink.add(p);
+
+    summary.processCount++;
+    summary.turnaroundTime.add(p.turnaroundTime);
+    summary.waitingTime.add(p.waitingTime);
+    summary.responseTime.add(p.responseTime);
+    summary.makespan = currentTime;
+}
+
+// Value counterparts of SJFKey and PriorityKey in Scheduler.cpp
+struct SJFValueComparator {
+    bool operator()(const Process& a, const Process& b) const {
+        if (a.burstTime == b.burstTime)
+            return a.arrivalTime > b.arrivalTime; // Earlier arrival wins
+        return a.burstTime > b.burstTime; // Shorter burst time wins
+    }
+};
+
+struct PriorityValueComparator {
+    bool operator()(const Process& a, const Process& b) const {
+        if (a.priority != b.priority)
+            return a.priority > b.priority;   // Lower priority value = higher priority
+        if (a.arrivalTime != b.arrivalTime)
+            return a.arrivalTime > b.arrivalTime; // Tie-breaker: earlier arrival
+        return a.pid > b.pid; // Tie-breaker: smaller PID
+    }
+};
+
+/**
+ * Streaming First-Come-First-Served
+ * Only the running process is resident.
+ *
+ * Time Complexity: O(n)
+ * Space Complexity: O(1)
+ */
+StreamSummary StreamFCFS(ProcessSource& source, ResultSink& sink) {
+    StreamSummary summary;
+    ArrivalStream arrivals(source);
+    int currentTime = 0;
+
+    sink.begin(ALGORITHM_TITLES[0]);
+    while (!arrivals.empty()) {
+        Process p = arrivals.take();
+        summary.peakReadyQueue = 1;
+
+        // If CPU is idle, wait until the process arrives
+        if (currentTime < p.arrivalTime)
+            currentTime = p.arrivalTime;
+
+        p.startTime = currentTime;
+        currentTime += p.burstTime;
+        finishProcess(p, currentTime, sink, summary);
+    }
+    sink.end();
+    return summary;
+}
+
+/**
+ * Streaming non-preemptive scheduling shared by SJF and Priority
+ *
+ * Time Complexity: O(n log m) where m is the peak ready queue size
+ * Space Complexity: O(m)
+ */
+template <typename Comparator>
+static StreamSummary streamNonPreemptive(ProcessSource& source, ResultSink& sink, const string& title) {
+    StreamSummary summary;
+    ArrivalStream arrivals(source);
+    priority_queue<Process, vector<Process>, Comparator> readyQueue;
+    int currentTime = 0;
+
+    sink.begin(title);
+    while (!arrivals.empty() || !readyQueue.empty()) {
+        // Pull every process that has arrived by currentTime
+        while (arrivals.arrivedBy(currentTime))
+            readyQueue.push(arrivals.take());
+        summary.peakReadyQueue = max(summary.peakReadyQueue, readyQueue.size());
+
+        // CPU idle case: jump to next arrival time
+        if (readyQueue.empty()) {
+            currentTime = arrivals.nextArrival();
+            continue;
+        }
+
+        // Execute the selected process completely (non-preemptive)
+        Process p = readyQueue.top();
+        readyQueue.pop();
+        p.startTime = currentTime;
+        currentTime += p.burstTime;
+        finishProcess(p, currentTime, sink, summary);
+    }
+    sink.end();
+    return summary;
+}
+
+StreamSummary StreamSJF_NonPreemptive(ProcessSource& source, ResultSink& sink) {
+    return streamNonPreemptive<SJFValueComparator>(source, sink, ALGORITHM_TITLES[1]);
+}
+
+StreamSummary StreamPriority_NonPreemptive(ProcessSource& source, ResultSink& sink) {
+    return streamNonPreemptive<PriorityValueComparator>(source, sink, ALGORITHM_TITLES[2]);
+}
+
+/**
+ * Skips whole Round Robin rounds with no arrival or completion
+ * (value counterpart of fastForwardRounds in Scheduler.cpp)
+ */
+static void fastForwardStreamRounds(deque<Process>& readyQueue, int& currentTime, int timeQuantum, int nextArrival) {
+    int minRemaining = INT_MAX;
+    for (const Process& p : readyQueue)
+        minRemaining = min(minRemaining, p.remainingTime);
+
+    // Every process must still have work left after the skipped rounds
+    long long rounds = (minRemaining - 1) / timeQuantum;
+
+    // The last skipped slice must end before the next arrival
+    long long roundLength = (long long)readyQueue.size() * timeQuantum;
+    if (nextArrival != INT_MAX)
+        rounds = min(rounds, (nextArrival - currentTime - 1) / roundLength);
+
+    if (rounds <= 0)
+        return;
+
+    // Processes that never ran start in the first skipped round
+    int sliceStart = currentTime;
+    for (Process& p : readyQueue) {
+        if (p.startTime < 0)
+            p.startTime = sliceStart;
+        sliceStart += timeQuantum;
+        p.remainingTime -= (int)(rounds * timeQuantum);
+    }
+    currentTime += (int)(rounds * roundLength);
+}
+
+/**
+ * Streaming Round Robin
+ *
+ * Time Complexity: O(n + s) where s is the number of simulated time slices
+ * Space Complexity: O(m) where m is the peak ready queue size
+ */
+StreamSummary StreamRoundRobin(ProcessSource& source, ResultSink& sink, int timeQuantum) {
+    StreamSummary summary;
+    ArrivalStream arrivals(source);
+    deque<Process> readyQueue;
+    int currentTime = 0;
+    size_t slicesUntilCheck = 0;
+
+    sink.begin(ALGORITHM_TITLES[3]);
+    while (!arrivals.empty() || !readyQueue.empty()) {
+        while (arrivals.arrivedBy(currentTime))
+            readyQueue.push_back(arrivals.take());
+
+        // CPU idle case: move currentTime to the arrival time of the next process
+        if (readyQueue.empty()) {
+            currentTime = arrivals.nextArrival();
+            continue;
+        }
+
+        if (slicesUntilCheck == 0) {
+            fastForwardStreamRounds(readyQueue, currentTime, timeQuantum,
+                arrivals.empty() ? INT_MAX : arrivals.nextArrival());
+            slicesUntilCheck = readyQueue.size();
+        }
+        slicesUntilCheck--;
+
+        Process p = readyQueue.front();
+        readyQueue.pop_front();
+        if (p.startTime < 0)
+            p.startTime = currentTime;
+
+        int execTime = min(p.remainingTime, timeQuantum);
+        p.remainingTime -= execTime;
+        currentTime += execTime;
+
+        // Processes arriving during the slice queue up ahead of the preempted one
+        while (arrivals.arrivedBy(currentTime))
+            readyQueue.push_back(arrivals.take());
+        summary.peakReadyQueue = max(summary.peakReadyQueue, readyQueue.size() + 1);
+
+        if (p.remainingTime > 0)
+            readyQueue.push_back(p);
+        else
+            finishProcess(p, currentTime, sink, summary);
+    }
+    sink.end();
+    return summary;
+}
+
+/**
+ * Streaming Multi-Level Queue (SYSTEM RR q=2 > INTERACTIVE priority > BATCH FCFS)
+ *
+ * Time Complexity: O(n log m + s) where s is the number of SYSTEM time slices
+ * Space Complexity: O(m) where m is the peak number of queued processes
+ */
+StreamSummary StreamMultiLevelQueue(ProcessSource& source, ResultSink& sink) {
+    StreamSummary summary;
+    ArrivalStream arrivals(source);
+    queue<Process> systemQueue;
+    priority_queue<Process, vector<Process>, PriorityValueComparator> interactiveQueue;
+    queue<Process> batchQueue;
+    int currentTime = 0;
+
+    const int TIME_QUANTUM = 2; // fixed quantum for SYSTEM queue
+
+    // Route every arrived process to its queue
+    auto admitArrivals = [&]() {
+        while (arrivals.arrivedBy(currentTime)) {
+            Process p = arrivals.take();
+            if (p.queueType == SYSTEM)
+                systemQueue.push(p);
+            else if (p.queueType == INTERACTIVE)
+                interactiveQueue.push(p);
+            else
+                batchQueue.push(p);
+        }
+        summary.peakReadyQueue = max(summary.peakReadyQueue,
+            systemQueue.size() + interactiveQueue.size() + batchQueue.size());
+    };
+
+    sink.begin(ALGORITHM_TITLES[6]);
+    while (!arrivals.empty() || !systemQueue.empty() || !interactiveQueue.empty() || !batchQueue.empty()) {
+        admitArrivals();
+
+        if (!systemQueue.empty()) {
+            Process p = systemQueue.front();
+            systemQueue.pop();
+            if (p.startTime < 0)
+                p.startTime = currentTime;
+
+            int execTime = min(TIME_QUANTUM, p.remainingTime);
+            p.remainingTime -= execTime;
+            currentTime += execTime;
+
+            admitArrivals();
+
+            if (p.remainingTime > 0)
+                systemQueue.push(p);
+            else
+                finishProcess(p, currentTime, sink, summary);
+        }
+        else if (!interactiveQueue.empty()) {
+            Process p = interactiveQueue.top();
+            interactiveQueue.pop();
+
+            // Execute process completely (non-preemptive)
+            p.startTime = currentTime;
+            currentTime += p.remainingTime;
+            finishProcess(p, currentTime, sink, summary);
+        }
+        else if (!batchQueue.empty()) {
+            Process p = batchQueue.front();
+            batchQueue.pop();
+
+            p.startTime = currentTime;
+            currentTime += p.remainingTime;
+            finishProcess(p, currentTime, sink, summary);
+        }
+        else {
+            // No process in any queue - jump to next arrival time
+            currentTime = arrivals.nextArrival();
+        }
+    }
+    sink.end();
+    return summary;
+}
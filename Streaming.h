@@ -0,0 +1,97 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstddef>
+#include "Process.h"
+#include "QuantileSketch.h"
+#include "ResultSink.h"
+#include "WorkloadIO.h"
+
+/**
+ * Supplies processes to a streaming scheduler in arrival order
+ */
+class ProcessSource {
+public:
+    virtual ~ProcessSource() {}
+
+    /**
+     * Pulls the next process
+     *
+     * @param process Receives the next process (arrival time never decreases)
+     * @return false once the source is exhausted or failed
+     */
+    virtual bool next(Process& process) = 0;
+
+    // Non-empty if the source stopped because of an error
+    virtual std::string error() const { return std::string(); }
+
+protected:
+    // Counts process as pulled; false once the last arrival plus all CPU time
+    // pulled passes INT_MAX, the bound on the schedulers' clock (see ProcessTable::makespanBound)
+    bool fitsClock(const Process& process);
+
+private:
+    long long pulledArrival = 0;   // latest arrival pulled
+    long long pulledWork = 0;      // CPU time of the processes pulled
+};
+
+// Streams processes from a vector already sorted by arrival time
+class VectorProcessSource : public ProcessSource {
+public:
+    explicit VectorProcessSource(const std::vector<Process>& processes) : processes(processes), index(0) {}
+    bool next(Process& process) override;
+
+private:
+    const std::vector<Process>& processes;
+    size_t index;
+};
+
+// Streams records straight out of a memory-mapped binary workload
+class MappedProcessSource : public ProcessSource {
+public:
+    explicit MappedProcessSource(const MappedWorkload& workload) : workload(workload), index(0) {}
+    bool next(Process& process) override;
+    std::string error() const override { return errorMessage; }
+
+private:
+    const MappedWorkload& workload;
+    size_t index;
+    std::string errorMessage;
+};
+
+// Streams a text workload line by line; the file must be sorted by arrival time
+class TextProcessSource : public ProcessSource {
+public:
+    bool open(const std::string& path, std::string& error) { return reader.open(path, error); }
+    bool next(Process& process) override;
+    std::string error() const override { return errorMessage.empty() ? reader.error() : errorMessage; }
+
+private:
+    TextWorkloadReader reader;
+    int lastArrival = 0;
+    std::string errorMessage;
+};
+
+// Running aggregates of a streaming run; finished processes are not kept
+struct StreamSummary {
+    long long processCount = 0;
+    QuantileSketch turnaroundTime;
+    QuantileSketch waitingTime;
+    QuantileSketch responseTime;
+    int makespan = 0;              // completion time of the last process
+    size_t peakReadyQueue = 0;     // largest number of resident processes
+};
+
+/*
+ * Streaming variants of the schedulers in Scheduler.h
+ *
+ * Processes are pulled from the source when their arrival time is reached,
+ * handed to the sink when they finish, and then dropped, so memory is bounded
+ * by the ready queue instead of the trace length. Each variant produces the
+ * same metrics as its vector counterpart for the same arrival order.
+ */
+StreamSummary StreamFCFS(ProcessSource& source, ResultSink& sink);
+StreamSummary StreamSJF_NonPreemptive(ProcessSource& source, ResultSink& sink);
+StreamSummary StreamPriority_NonPreemptive(ProcessSource& source, ResultSink& sink);
+StreamSummary StreamRoundRobin(ProcessSource& source, ResultSink& sink, int timeQuantum);
+StreamSummary StreamMultiLevelQueue(ProcessSource& source, ResultSink& sink);
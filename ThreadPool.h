@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * Fixed set of worker threads running submitted tasks in FIFO order
+ *
+ * Tasks must not throw. wait() blocks until every task submitted so far has
+ * finished, so one pool can run several batches of work.
+ */
+class ThreadPool {
+public:
+    // threadCount 0 uses one thread per hardware thread
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    void wait();
+
+    unsigned size() const { return (unsigned)workers.size(); }
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskReady;
+    std::condition_variable allDone;
+    size_t pending = 0; // queued plus running tasks
+    bool stopping = false;
+};
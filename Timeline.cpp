@@ -0,0 +1,84 @@
+#include "Timeline.h"
+#include <string>
+
+using namespace std;
+
+Timeline::Timeline(size_t capacity) : capacity(capacity > 1 ? capacity : 2) {
+    buffer.reserve(this->capacity);
+}
+
+void Timeline::streamTo(FILE* file) {
+    out = file;
+    fputs("pid,start,end\n", out);
+}
+
+static void writeSegments(const TimelineSegment* segments, size_t count, FILE* out) {
+    for (size_t i = 0; i < count; i++)
+        fprintf(out, "%d,%d,%d\n", segments[i].pid, segments[i].start, segments[i].end);
+}
+
+void Timeline::flush() {
+    // The last segment stays buffered: the next slice may still extend it
+    size_t count = buffer.size() - 1;
+    writeSegments(buffer.data(), count, out);
+    written += count;
+    buffer.erase(buffer.begin(), buffer.begin() + count);
+}
+
+void Timeline::finish() {
+    if (!out)
+        return;
+    writeSegments(buffer.data(), buffer.size(), out);
+    written += buffer.size();
+    buffer.clear();
+    lastProcess = -1;
+    if (fflush(out) != 0 || ferror(out))
+        writeFailed = true;
+}
+
+void Timeline::clear() {
+    buffer.clear();
+    written = 0;
+    lastProcess = -1;
+}
+
+void writeTimelineCsv(const vector<TimelineSegment>& segments, FILE* out) {
+    fputs("pid,start,end\n", out);
+    writeSegments(segments.data(), segments.size(), out);
+    fflush(out);
+}
+
+void printGantt(const vector<TimelineSegment>& segments, FILE* out, size_t maxSegments) {
+    fputs("  Gantt Chart\n", out);
+    if (segments.size() > maxSegments) {
+        fprintf(out, "  (%zu segments, too long to draw; use batch mode --timeline to export)\n\n", segments.size());
+        return;
+    }
+
+    // Bar row with one cell per segment (or idle gap); time row below the cell borders
+    string bars = "  |";
+    string times = "  ";
+    int previousEnd = segments.empty() ? 0 : segments[0].start;
+    times += to_string(previousEnd);
+
+    auto addCell = [&](const string& label, int end) {
+        string cell = " " + label + " ";
+        string endTime = to_string(end);
+        if (cell.size() < endTime.size() + 1)
+            cell.resize(endTime.size() + 1, ' ');
+        bars += cell + "|";
+        // Align the end time under the closing border
+        size_t column = bars.size() - 1;
+        if (times.size() < column)
+            times.append(column - times.size(), ' ');
+        times += endTime;
+    };
+
+    for (const TimelineSegment& s : segments) {
+        if (s.start > previousEnd)
+            addCell("idle", s.start);
+        addCell("P" + to_string(s.pid), s.end);
+        previousEnd = s.end;
+    }
+    fprintf(out, "%s\n%s\n\n", bars.c_str(), times.c_str());
+}
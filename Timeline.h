@@ -0,0 +1,80 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdio>
+
+// One stretch of time during which a single process held the CPU
+struct TimelineSegment {
+    int pid;
+    int start;
+    int end;
+};
+
+/**
+ * Run-length Gantt timeline of a scheduling run
+ *
+ * Attach one to ScheduleResult::timeline before running an algorithm. Slices
+ * of the same process that touch (end of one == start of the next) are merged
+ * into a single segment, so a process that keeps the CPU across many
+ * scheduling decisions costs one entry.
+ *
+ * Segments go to a pre-reserved buffer. In streaming mode (streamTo) a full
+ * buffer is written out as CSV instead of growing, so arbitrarily long
+ * timelines need constant memory.
+ */
+class Timeline {
+public:
+    explicit Timeline(size_t capacity = 1 << 16);
+
+    // Writes the "pid,start,end" header and streams full buffers to out from now on
+    void streamTo(FILE* out);
+
+    // Records that table index process (with the given pid) ran from start to end
+    void record(int process, int pid, int start, int end) {
+        if (process == lastProcess && !buffer.empty() && buffer.back().end == start) {
+            buffer.back().end = end;
+            return;
+        }
+        if (out && buffer.size() == capacity)
+            flush();
+        TimelineSegment segment = { pid, start, end };
+        buffer.push_back(segment);
+        lastProcess = process;
+    }
+
+    // Writes the remaining segments in streaming mode
+    void finish();
+
+    // True if finish() found that streamed segments could not be written
+    bool failed() const { return writeFailed; }
+
+    void clear();
+
+    // Buffered segments: the whole timeline unless streaming
+    const std::vector<TimelineSegment>& segments() const { return buffer; }
+
+    // Segments recorded so far, including streamed ones
+    size_t size() const { return written + buffer.size(); }
+
+private:
+    void flush();
+
+    std::vector<TimelineSegment> buffer;
+    size_t capacity;
+    size_t written = 0;
+    int lastProcess = -1;
+    FILE* out = nullptr;
+    bool writeFailed = false;
+};
+
+/**
+ * Writes segments as CSV ("pid,start,end")
+ */
+void writeTimelineCsv(const std::vector<TimelineSegment>& segments, FILE* out);
+
+/**
+ * Prints a text Gantt chart, with idle gaps, for short timelines
+ *
+ * @param maxSegments Longer timelines only get a one-line note
+ */
+void printGantt(const std::vector<TimelineSegment>& segments, FILE* out, size_t maxSegments = 40);
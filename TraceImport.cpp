@@ -0,0 +1,597 @@
+#include "TraceImport.h"
+#include "WorkloadIO.h"
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <climits>
+
+using namespace std;
+
+const char* const KERNEL_TRACE_TITLE = "Linux Kernel (trace)";
+
+// Highest pid Linux hands out (PID_MAX_LIMIT); pids index a flat array
+static const int MAX_TRACE_PID = 4194304;
+
+// Highest CPU number accepted from a trace
+static const int MAX_TRACE_CPU = 65535;
+
+// Kernel priorities below this one are real-time
+static const int FIRST_NORMAL_PRIORITY = 100;
+
+// Kernel priority of nice 0
+static const int NICE_0_PRIORITY = 120;
+
+enum TraceEventType { NO_EVENT, SWITCH_EVENT, WAKEUP_EVENT };
+
+// One scheduler event of the trace
+struct TraceEvent {
+    TraceEventType type = NO_EVENT;
+    long long time = 0;      // nanoseconds
+    int cpu = 0;
+    int pid = 0;             // wakeups: the woken task; switches: the task switched out
+    int priority = 0;
+    char state = 'R';        // switches: 'R' preempted, 'S' went to sleep, 'X' exited
+    int nextPid = 0;         // switches: the task switched in
+    int nextPriority = 0;
+};
+
+// First occurrence of text in [begin, end), nullptr if there is none
+static const char* findText(const char* begin, const char* end, const char* text) {
+    const char* found = search(begin, end, text, text + strlen(text));
+    return found == end ? nullptr : found;
+}
+
+// Last occurrence of text in [begin, end), nullptr if there is none
+static const char* findLastText(const char* begin, const char* end, const char* text) {
+    const char* found = find_end(begin, end, text, text + strlen(text));
+    return found == end ? nullptr : found;
+}
+
+static bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * Parses a decimal integer, optionally negative, at p
+ *
+ * @return The position after the number, or nullptr if there is none or it overflows an int
+ */
+static const char* parseInt(const char* p, const char* end, int& value) {
+    bool negative = p < end && *p == '-';
+    if (negative)
+        p++;
+    if (p == end || !isDigit(*p))
+        return nullptr;
+    long long result = 0;
+    while (p < end && isDigit(*p)) {
+        result = result * 10 + (*p - '0');
+        if (result > INT_MAX)
+            return nullptr;
+        p++;
+    }
+    value = (int)(negative ? -result : result);
+    return p;
+}
+
+// Reads the integer after key (e.g. " prev_pid=") in [begin, end)
+static bool parseKey(const char* begin, const char* end, const char* key, int& value) {
+    const char* p = findText(begin, end, key);
+    return p && parseInt(p + strlen(key), end, value);
+}
+
+/**
+ * Reduces a task state as printed by the kernel (R, R+, S, D, I, X, Z, D|K, ...)
+ * to 'R' (still runnable), 'X' (exited) or 'S' (asleep)
+ */
+static char classifyState(const char* p, const char* end) {
+    while (p < end && *p == ' ')
+        p++;
+    if (p < end && *p == 'R')
+        return 'R';
+    for (; p < end && *p != ' '; p++) {
+        if (*p == 'X' || *p == 'Z')
+            return 'X';
+    }
+    return 'S';
+}
+
+/**
+ * Parses a task in the compact "comm:pid [prio]" form; the last " [" of the
+ * range opens the priority, so the command name may hold ':' and spaces
+ *
+ * @param rest Receives the position after the closing ']'
+ */
+static bool parseCompactTask(const char* begin, const char* end, int& pid, int& priority, const char*& rest) {
+    const char* bracket = findLastText(begin, end, " [");
+    if (!bracket)
+        return false;
+    const char* digits = bracket;
+    while (digits > begin && isDigit(digits[-1]))
+        digits--;
+    if (digits == bracket || digits == begin || digits[-1] != ':' || !parseInt(digits, bracket, pid))
+        return false;
+    rest = parseInt(bracket + 2, end, priority);
+    if (!rest || rest == end || *rest != ']')
+        return false;
+    rest++;
+    return true;
+}
+
+/**
+ * Finds the scheduler event of a line: "sched_switch:", "sched_wakeup:" or
+ * "sched_wakeup_new:", as a word of its own or after perf's "sched:"
+ *
+ * @param name Receives the start of the event name
+ * @param body Receives the start of the event fields
+ */
+static TraceEventType findEvent(const char* begin, const char* end, const char*& name, const char*& body) {
+    static const struct {
+        const char* suffix;
+        TraceEventType type;
+    } EVENTS[] = { { "switch:", SWITCH_EVENT }, { "wakeup:", WAKEUP_EVENT }, { "wakeup_new:", WAKEUP_EVENT } };
+
+    for (const char* p = begin; (p = findText(p, end, "sched_")) != nullptr; p++) {
+        if (p == begin || (p[-1] != ' ' && p[-1] != ':'))
+            continue;
+        const char* suffix = p + 6;
+        for (const auto& event : EVENTS) {
+            size_t length = strlen(event.suffix);
+            if ((size_t)(end - suffix) >= length && memcmp(suffix, event.suffix, length) == 0) {
+                name = p;
+                body = suffix + length;
+                while (body < end && *body == ' ')
+                    body++;
+                return event.type;
+            }
+        }
+    }
+    return NO_EVENT;
+}
+
+/**
+ * Reads the timestamp ("seconds.fraction:") and the CPU ("[nnn]") in the part
+ * of a line before the event name; they are the last such tokens there
+ */
+static bool parsePrefix(const char* begin, const char* end, TraceEvent& event) {
+    const char* stamp = nullptr;
+    const char* colon = end;
+    while (!stamp && colon > begin) {
+        colon--;
+        if (*colon != ':')
+            continue;
+        const char* p = colon;
+        while (p > begin && isDigit(p[-1]))
+            p--;
+        if (p == colon || p == begin || p[-1] != '.')
+            continue;
+        const char* dot = p - 1;
+        p = dot;
+        while (p > begin && isDigit(p[-1]))
+            p--;
+        if (p < dot && (p == begin || p[-1] == ' '))
+            stamp = p;
+    }
+    if (!stamp)
+        return false;
+
+    long long seconds = 0, nanoseconds = 0;
+    const char* p = stamp;
+    for (; *p != '.'; p++) {
+        seconds = seconds * 10 + (*p - '0');
+        if (seconds > LLONG_MAX / 1000000000LL / 10)
+            return false;
+    }
+    int digits = 0;
+    for (p++; p < colon; p++) {
+        if (digits < 9) {
+            nanoseconds = nanoseconds * 10 + (*p - '0');
+            digits++;
+        }
+    }
+    for (; digits < 9; digits++)
+        nanoseconds *= 10;
+    event.time = seconds * 1000000000LL + nanoseconds;
+
+    // The CPU is the last "[digits]" before the timestamp (0 if the format has none)
+    event.cpu = 0;
+    for (const char* close = stamp; close > begin; ) {
+        close--;
+        if (*close != ']')
+            continue;
+        const char* open = close;
+        while (open > begin && isDigit(open[-1]))
+            open--;
+        if (open < close && open > begin && open[-1] == '[') {
+            parseInt(open, close, event.cpu);
+            break;
+        }
+    }
+    return event.cpu <= MAX_TRACE_CPU;
+}
+
+// Parses the fields of a sched_switch event
+static bool parseSwitch(const char* body, const char* end, TraceEvent& event) {
+    const char* state;
+    if (end - body >= 10 && memcmp(body, "prev_comm=", 10) == 0) {
+        if (!parseKey(body, end, " prev_pid=", event.pid) || !parseKey(body, end, " prev_prio=", event.priority)
+            || !parseKey(body, end, " next_pid=", event.nextPid)
+            || !parseKey(body, end, " next_prio=", event.nextPriority))
+            return false;
+        state = findText(body, end, " prev_state=");
+        if (!state)
+            return false;
+        state += 12;
+    }
+    else {
+        // comm:pid [prio] state ==> comm:pid [prio]
+        const char* arrow = findText(body, end, " ==> ");
+        const char* rest;
+        if (!arrow || !parseCompactTask(body, arrow, event.pid, event.priority, state)
+            || !parseCompactTask(arrow + 5, end, event.nextPid, event.nextPriority, rest))
+            return false;
+        end = arrow;
+    }
+    event.state = classifyState(state, end);
+    return event.pid >= 0 && event.pid <= MAX_TRACE_PID && event.nextPid >= 0 && event.nextPid <= MAX_TRACE_PID;
+}
+
+// Parses the fields of a sched_wakeup or sched_wakeup_new event
+static bool parseWakeup(const char* body, const char* end, TraceEvent& event) {
+    const char* rest;
+    bool parsed = end - body >= 5 && memcmp(body, "comm=", 5) == 0
+        ? parseKey(body, end, " pid=", event.pid) && parseKey(body, end, " prio=", event.priority)
+        : parseCompactTask(body, end, event.pid, event.priority, rest);
+    return parsed && event.pid >= 0 && event.pid <= MAX_TRACE_PID;
+}
+
+/**
+ * Parses one trace line
+ *
+ * @return false for a scheduler event whose fields do not parse; event.type
+ *         is NO_EVENT for a line without a scheduler event
+ */
+static bool parseLine(const char* begin, const char* end, TraceEvent& event) {
+    const char* name;
+    const char* body;
+    event.type = findEvent(begin, end, name, body);
+    if (event.type == NO_EVENT)
+        return true;
+    if (end > body && end[-1] == '\r')
+        end--;
+    if (!parsePrefix(begin, name, event))
+        return false;
+    return event.type == SWITCH_EVENT ? parseSwitch(body, end, event) : parseWakeup(body, end, event);
+}
+
+enum TaskState { TASK_RUNNABLE, TASK_RUNNING, TASK_SLEEPING, TASK_EXITED };
+
+// A sleep of a task, with the CPU busy time of the trace up to either end
+struct TraceSleep {
+    int start;
+    int end;
+    long long busyAtStart;
+    long long busyAtEnd;
+};
+
+// One task lifetime being rebuilt from the trace
+struct TraceTask {
+    int pid = 0;
+    int priority = 0;        // kernel priority
+    int arrival = 0;
+    int firstRun = -1;
+    int completion = 0;      // end of its last finished CPU burst
+    TaskState state = TASK_RUNNABLE;
+    int since = 0;           // when it started running (TASK_RUNNING) or went to sleep (TASK_SLEEPING)
+    int lastRan = 0;         // end of its last slice
+    int cpuTime = 0;         // CPU time of the burst in progress
+    long long busyAtSleep = 0;   // CPU busy time of the trace when it went to sleep
+    vector<int> bursts;      // cpu, io, cpu, ...: even size while in a CPU burst, odd while asleep
+    vector<TraceSleep> sleeps;   // one per I/O burst of bursts
+};
+
+/**
+ * Replays scheduler events into per-task burst sequences
+ * Relies on the invariant of TraceTask::bursts: a wakeup appends the sleep,
+ * a switch-out that blocks appends the CPU burst.
+ *
+ * It also keeps the time during which at least one CPU runs a task (counted
+ * from each CPU's first switch), so that every sleep knows how much of it
+ * overlapped with CPU work.
+ */
+class TraceReplay {
+public:
+    vector<TraceTask> tasks;
+    long long contextSwitches = 0;
+    int cpus = 0;
+
+    void wakeup(const TraceEvent& event, int time) {
+        advance(time);
+        if (event.pid == 0)
+            return;
+        TraceTask& task = taskOf(event.pid, event.priority, time, TASK_RUNNABLE);
+        if (task.state == TASK_SLEEPING)
+            wake(task, time);
+    }
+
+    void contextSwitch(const TraceEvent& event, int time) {
+        advance(time);
+        if (event.cpu >= (int)lastOnCpu.size()) {
+            lastOnCpu.resize(event.cpu + 1, -2);
+            cpuBusy.resize(event.cpu + 1, false);
+        }
+        if (lastOnCpu[event.cpu] == -2) {
+            lastOnCpu[event.cpu] = -1;
+            cpus++;
+        }
+
+        if (event.pid != 0) {
+            // A task first seen leaving the CPU has been running since the trace started
+            TraceTask& task = taskOf(event.pid, event.priority, 0, TASK_RUNNING);
+            if (task.state == TASK_SLEEPING)
+                wake(task, time);
+            if (task.state == TASK_RUNNING)
+                task.cpuTime += time - task.since;
+            task.lastRan = time;
+            if (task.firstRun < 0)
+                task.firstRun = time;   // its switch-in was not in the trace
+            if (event.state == 'R') {
+                task.state = TASK_RUNNABLE;
+            }
+            else {
+                task.bursts.push_back(task.cpuTime);
+                task.cpuTime = 0;
+                task.completion = time;
+                task.state = event.state == 'X' ? TASK_EXITED : TASK_SLEEPING;
+                task.since = time;
+                task.busyAtSleep = busyTime;
+            }
+        }
+
+        if (event.nextPid != 0) {
+            TraceTask& task = taskOf(event.nextPid, event.nextPriority, time, TASK_RUNNABLE);
+            if (task.state == TASK_SLEEPING)
+                wake(task, time);
+            task.state = TASK_RUNNING;
+            task.since = time;
+            if (task.firstRun < 0)
+                task.firstRun = time;
+            int k = pidSlot[event.nextPid];
+            if (lastOnCpu[event.cpu] >= 0 && lastOnCpu[event.cpu] != k)
+                contextSwitches++;
+            lastOnCpu[event.cpu] = k;
+        }
+
+        bool busy = event.nextPid != 0;
+        busyCpus += (int)busy - (int)cpuBusy[event.cpu];
+        cpuBusy[event.cpu] = busy;
+    }
+
+    // Ends every task at the end of the trace (see importSchedTrace)
+    void finish(int end) {
+        for (TraceTask& task : tasks) {
+            if (task.state == TASK_RUNNING) {
+                task.bursts.push_back(task.cpuTime + end - task.since);
+                task.completion = end;
+            }
+            else if (task.state == TASK_RUNNABLE && task.bursts.size() % 2 == 0) {
+                if (task.cpuTime > 0) {
+                    task.bursts.push_back(task.cpuTime);
+                    task.completion = task.lastRan;
+                }
+                else if (!task.bursts.empty()) {
+                    task.bursts.pop_back();   // woken but not run again: drop the last sleep
+                    task.sleeps.pop_back();
+                }
+            }
+        }
+    }
+
+private:
+    vector<int> pidSlot;     // index into tasks of each pid's current lifetime, -1 if none
+    vector<int> lastOnCpu;   // task that last ran on each CPU: -1 none yet, -2 CPU not seen
+    vector<bool> cpuBusy;    // each CPU runs a task (not the idle task)
+    int busyCpus = 0;
+    int lastTime = 0;
+    long long busyTime = 0;  // time before lastTime during which a CPU was busy
+
+    void advance(int time) {
+        if (busyCpus > 0)
+            busyTime += time - lastTime;
+        lastTime = time;
+    }
+
+    TraceTask& taskOf(int pid, int priority, int arrival, TaskState state) {
+        if (pid >= (int)pidSlot.size())
+            pidSlot.resize(pid + 1, -1);
+        int& k = pidSlot[pid];
+        if (k < 0 || tasks[k].state == TASK_EXITED) {
+            k = (int)tasks.size();
+            tasks.emplace_back();
+            TraceTask& task = tasks.back();
+            task.pid = pid;
+            task.priority = priority;
+            task.arrival = arrival;
+            task.state = state;
+            task.since = arrival;
+            if (state == TASK_RUNNING)
+                task.firstRun = arrival;
+        }
+        return tasks[k];
+    }
+
+    void wake(TraceTask& task, int time) {
+        task.bursts.push_back(time - task.since);
+        TraceSleep sleep = { task.since, time, task.busyAtSleep, busyTime };
+        task.sleeps.push_back(sleep);
+        task.state = TASK_RUNNABLE;
+    }
+};
+
+/**
+ * Merges the bursts shorter than one unit into their neighbours: a zero
+ * sleep joins the CPU bursts around it, a zero CPU burst inside the
+ * sequence joins the sleeps around it, and one at either end becomes 1
+ */
+static void normalizeBursts(const vector<int>& bursts, vector<int>& out) {
+    out.assign(1, bursts[0]);
+    for (size_t k = 1; k + 1 < bursts.size(); k += 2) {
+        int io = bursts[k], cpu = bursts[k + 1];
+        if (io == 0) {
+            out.back() += cpu;
+        }
+        else if (out.back() == 0 && out.size() > 1) {
+            out.pop_back();
+            out.back() += io;
+            out.push_back(cpu);
+        }
+        else {
+            out.push_back(io);
+            out.push_back(cpu);
+        }
+    }
+    if (out.front() == 0)
+        out.front() = 1;
+    if (out.back() == 0)
+        out.back() = 1;
+}
+
+/**
+ * Sets the I/O busy time of the kernel's schedule (the union of the sleeps of
+ * the imported tasks) and the CPU busy time within it
+ *
+ * Time Complexity: O(s log s) where s is the number of sleeps
+ */
+static void measureKernelIo(const TraceReplay& replay, const vector<int>& order, ScheduleResult& kernel) {
+    vector<TraceSleep> sleeps;
+    for (int k : order)
+        sleeps.insert(sleeps.end(), replay.tasks[k].sleeps.begin(), replay.tasks[k].sleeps.end());
+    sort(sleeps.begin(), sleeps.end(), [](const TraceSleep& a, const TraceSleep& b) { return a.start < b.start; });
+
+    // Merge overlapping sleeps; the busy time at a merged interval's ends comes from the sleeps that end it
+    for (size_t k = 0; k < sleeps.size(); ) {
+        TraceSleep merged = sleeps[k++];
+        while (k < sleeps.size() && sleeps[k].start <= merged.end) {
+            if (sleeps[k].end > merged.end) {
+                merged.end = sleeps[k].end;
+                merged.busyAtEnd = sleeps[k].busyAtEnd;
+            }
+            k++;
+        }
+        kernel.ioBusyTime += merged.end - merged.start;
+        kernel.ioOverlapTime += merged.busyAtEnd - merged.busyAtStart;
+        kernel.ioEnd = max(kernel.ioEnd, merged.end);
+    }
+}
+
+bool importSchedTrace(const string& path, const TraceImportOptions& options, ProcessTable& table,
+    ScheduleResult& kernel, TraceImportStats& stats, string& error)
+{
+    LineReader lines;
+    if (!lines.open(path, error))
+        return false;
+
+    stats = TraceImportStats();
+    TraceReplay replay;
+    TraceEvent event;
+    long long first = 0, last = 0;
+    int now = 0;
+    const char* lineBegin;
+    const char* lineEnd;
+    while (lines.next(lineBegin, lineEnd)) {
+        stats.lines++;
+        if (!parseLine(lineBegin, lineEnd, event)) {
+            stats.malformedLines++;
+            continue;
+        }
+        if (event.type == NO_EVENT)
+            continue;
+
+        if (stats.switchEvents + stats.wakeupEvents == 0)
+            first = last = event.time;
+        if (event.time < last) {
+            stats.outOfOrder++;
+            event.time = last;
+        }
+        last = event.time;
+        long long units = (last - first) / options.unitNanoseconds;
+        if (units > INT_MAX) {
+            error = path + ":" + to_string(stats.lines) + ": the trace spans more than " + to_string(INT_MAX)
+                + " time units, use a longer time unit";
+            return false;
+        }
+        now = (int)units;
+
+        if (event.type == SWITCH_EVENT) {
+            stats.switchEvents++;
+            replay.contextSwitch(event, now);
+        }
+        else {
+            stats.wakeupEvents++;
+            replay.wakeup(event, now);
+        }
+    }
+    if (lines.readError()) {
+        error = "read error in " + path;
+        return false;
+    }
+    if (stats.switchEvents == 0) {
+        error = path + " contains no sched_switch events";
+        return false;
+    }
+    replay.finish(now);
+    stats.span = now;
+    stats.cpus = replay.cpus;
+    stats.tasks = (long long)replay.tasks.size();
+
+    // Tasks in arrival order, ties in the order the trace introduced them
+    vector<int> order;
+    for (int k = 0; k < (int)replay.tasks.size(); k++) {
+        if (replay.tasks[k].bursts.empty())
+            stats.tasksWithoutCpu++;
+        else
+            order.push_back(k);
+    }
+    stable_sort(order.begin(), order.end(), [&replay](int a, int b) {
+        return replay.tasks[a].arrival < replay.tasks[b].arrival;
+    });
+
+    table.clear();
+    table.reserve(order.size());
+    vector<int> bursts;
+    for (int k : order) {
+        const TraceTask& task = replay.tasks[k];
+        normalizeBursts(task.bursts, bursts);
+        long long cpu = 0, io = 0;
+        for (size_t b = 0; b < bursts.size(); b++)
+            (b % 2 == 0 ? cpu : io) += bursts[b];
+        QueueType queue = task.priority < FIRST_NORMAL_PRIORITY ? SYSTEM : io > cpu ? INTERACTIVE : BATCH;
+        table.add(task.pid, task.arrival, bursts.data(), bursts.size(), task.priority - NICE_0_PRIORITY, queue);
+    }
+
+    // What the kernel achieved, with the formulas of ScheduleResult::complete
+    kernel.reset(table);
+    kernel.cpuCount = max(replay.cpus, 1);
+    measureKernelIo(replay, order, kernel);
+    for (size_t i = 0; i < table.size(); i++) {
+        const TraceTask& task = replay.tasks[order[i]];
+        int io = table.hasIo() ? table.ioTime[i] : 0;
+        kernel.remainingTime[i] = 0;
+        kernel.completionTime[i] = task.completion;
+        kernel.turnaroundTime[i] = task.completion - task.arrival;
+        kernel.waitingTime[i] = max(0, kernel.turnaroundTime[i] - table.burstTime[i] - io);
+        kernel.startTime[i] = task.firstRun;
+        kernel.responseTime[i] = task.firstRun - task.arrival;
+    }
+    kernel.contextSwitches = replay.contextSwitches;
+    return true;
+}
+
+void printTraceImportStats(const TraceImportStats& stats, const TraceImportOptions& options, FILE* out) {
+    fprintf(out, "trace_lines=%lld switches=%lld wakeups=%lld tasks=%lld tasks_without_cpu=%lld cpus=%d"
+        " span=%lld unit_ns=%lld malformed=%lld out_of_order=%lld\n",
+        stats.lines, stats.switchEvents, stats.wakeupEvents, stats.tasks, stats.tasksWithoutCpu, stats.cpus,
+        stats.span, options.unitNanoseconds, stats.malformedLines, stats.outOfOrder);
+    if (stats.cpus > 1)
+        fprintf(out, "note: the trace covers %d CPUs, the simulated algorithms run on one\n", stats.cpus);
+    fflush(out);
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <string>
+#include <cstdio>
+#include "ProcessTable.h"
+
+// Title of the kernel's own schedule in reports and comparisons
+extern const char* const KERNEL_TRACE_TITLE;
+
+// Trace import parameters
+struct TraceImportOptions {
+    long long unitNanoseconds = 1000;   // trace time per simulated time unit (default 1 µs)
+};
+
+// What an import read and how it was mapped
+struct TraceImportStats {
+    long long lines = 0;
+    long long switchEvents = 0;
+    long long wakeupEvents = 0;
+    long long malformedLines = 0;   // scheduler events whose fields did not parse (skipped)
+    long long outOfOrder = 0;       // events stamped before the previous one (moved to its time)
+    int cpus = 0;                   // CPUs seen in the switch events
+    long long tasks = 0;            // task lifetimes (a pid reused after its task exited starts a new one)
+    long long tasksWithoutCpu = 0;  // tasks that never ran inside the trace (not imported)
+    long long span = 0;             // first to last event, in time units
+};
+
+/**
+ * Rebuilds a workload and the schedule the kernel ran from a scheduler trace
+ *
+ * Reads a text dump of the sched_switch, sched_wakeup and sched_wakeup_new
+ * events in one pass: ftrace's trace file, `perf script` / `perf sched
+ * script` and `trace-cmd report` output, with the fields either as
+ * key=value pairs (prev_pid=12 ...) or in the compact comm:pid [prio] form.
+ * Other lines are ignored. Each task lifetime becomes one process:
+ *
+ *  - it arrives when it is first woken (or first seen, for a task already
+ *    running or runnable when the trace starts);
+ *  - a CPU burst is the CPU time from a wakeup to the switch-out that puts
+ *    the task to sleep (preemptions, prev_state R, do not end it), and an
+ *    I/O burst is the sleep until the next wakeup;
+ *  - its priority is the kernel priority minus 120, which is the nice value
+ *    for normal tasks and below -20 for real-time ones; real-time tasks go to
+ *    the SYSTEM queue, tasks that sleep longer than they run to INTERACTIVE
+ *    and the others to BATCH.
+ *
+ * Times are counted from the first event in whole time units. A CPU burst
+ * shorter than one unit is merged into the sleeps around it (or rounded up
+ * to one unit at the start or end of a task), and so is a sleep shorter than
+ * one unit into the bursts around it. The trace ends every task: one still
+ * running ends with the trace, one waiting for the CPU ends where it last
+ * ran. The same times give the kernel's own metrics, computed like a
+ * simulated run's, so the kernel row compares directly with the simulators:
+ * its I/O busy time is the union of the imported sleeps, and its overlap the
+ * part of it during which a CPU ran a task. Its CPU utilization is averaged
+ * over the CPUs of the trace. The simulators model one CPU: compare with a
+ * trace of one CPU for like-for-like numbers.
+ *
+ * Memory is O(t + b) for t tasks and b bursts, whatever the trace size.
+ *
+ * Time Complexity: O(L + t log t) where L is the trace size in bytes
+ *
+ * @param path Trace file
+ * @param options Time unit of the workload
+ * @param table Receives one process per task, sorted by arrival time
+ * @param kernel Receives the kernel's metrics for every process of table
+ * @param stats Receives the import counters
+ * @param error Receives a description of the problem on failure
+ * @return false if the file cannot be read, holds no sched_switch event or
+ *         spans more time units than an int holds
+ */
+bool importSchedTrace(const std::string& path, const TraceImportOptions& options, ProcessTable& table,
+    ScheduleResult& kernel, TraceImportStats& stats, std::string& error);
+
+// Writes the import counters as one line (plus a note for multi-CPU traces)
+void printTraceImportStats(const TraceImportStats& stats, const TraceImportOptions& options, FILE* out);
@@ -1,10 +1,13 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <cstdio>
 #include "Process.h"
 
 
 void sortByArrivalTime(std::vector<Process>& processes);
 
+FILE* openFile(const std::string& path, const char* mode);
+
 void printResults(const std::vector<Process>& processes, const std::string& title);
 
@@ -0,0 +1,374 @@
+#include "WorkloadGenerator.h"
+#include "WorkloadIO.h"
+#include "Utils.h"
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <climits>
+#include <algorithm>
+
+using namespace std;
+
+// Processes per RNG stream; fixed so the output does not depend on the thread count
+static const size_t CHUNK_SIZE = 1 << 16;
+
+// Longest generated burst, keeps heavy Pareto tails inside the int range
+// (with I/O, the cap is shared by the CPU bursts of a process, and by its I/O bursts)
+static const double MAX_BURST = 1e9;
+
+// Most I/O bursts per generated process
+static const int MAX_IO_BURSTS = 1000;
+
+// Bursty arrivals: gaps inside a cluster, as a fraction of the mean interarrival
+static const double CLUSTER_GAP_FRACTION = 0.1;
+
+/**
+ * Draws the fields of one process at a time from the configured distributions
+ */
+class ProcessSampler {
+public:
+    ProcessSampler(const GeneratorOptions& options, size_t chunk) : options(options) {
+        // Independent stream per (seed, chunk)
+        SplitMix64 seeder = { options.seed ^ (0xD1B54A32D192ED03ull * (chunk + 1)) };
+        rng.state = seeder.next();
+
+        clusterStartChance = 1.0 / options.meanClusterSize;
+        clusterGap = CLUSTER_GAP_FRACTION * options.meanInterarrival;
+        // Keeps the long-run mean gap at meanInterarrival
+        clusterStartGap = (options.meanInterarrival - (1.0 - clusterStartChance) * clusterGap) / clusterStartChance;
+
+        double mixTotal = options.queueMix[0] + options.queueMix[1] + options.queueMix[2];
+        systemShare = options.queueMix[0] / mixTotal;
+        interactiveShare = systemShare + options.queueMix[1] / mixTotal;
+
+        paretoScale = options.meanBurst * (options.paretoShape - 1.0) / options.paretoShape;
+        cpuCap = MAX_BURST / (options.ioBursts + 1);
+        ioCap = options.ioBursts > 0 ? MAX_BURST / options.ioBursts : MAX_BURST;
+    }
+
+    long long interarrival() {
+        double gap;
+        if (options.arrivals == POISSON_ARRIVALS)
+            gap = exponential(options.meanInterarrival);
+        else if (rng.uniform() < clusterStartChance)
+            gap = exponential(clusterStartGap);
+        else
+            gap = exponential(clusterGap);
+        // Randomized rounding keeps the mean gap exact even for sub-unit means
+        return (long long)(gap + rng.uniform());
+    }
+
+    int burst() {
+        double value;
+        if (options.bursts == UNIFORM_BURSTS)
+            value = 1.0 + rng.uniform() * (2.0 * options.meanBurst - 2.0); // 1 .. 2 * mean - 1
+        else if (options.bursts == EXPONENTIAL_BURSTS)
+            value = exponential(options.meanBurst);
+        else if (options.bursts == PARETO_BURSTS)
+            value = paretoScale / pow(1.0 - rng.uniform(), 1.0 / options.paretoShape);
+        else
+            value = exponential(rng.uniform() < options.longFraction ? options.longBurst : options.meanBurst);
+        return (int)max(1.0, min(cpuCap, nearbyint(value)));
+    }
+
+    int ioBurst() { return (int)max(1.0, min(ioCap, nearbyint(exponential(options.meanIo)))); }
+
+    int priority() { return (int)(rng.next() % (uint64_t)options.priorityLevels); }
+
+    QueueType queueType() {
+        double u = rng.uniform();
+        if (u < systemShare) return SYSTEM;
+        if (u < interactiveShare) return INTERACTIVE;
+        return BATCH;
+    }
+
+private:
+    double exponential(double mean) { return -mean * log1p(-rng.uniform()); }
+
+    const GeneratorOptions& options;
+    SplitMix64 rng;
+    double clusterStartChance;
+    double clusterGap;
+    double clusterStartGap;
+    double systemShare;
+    double interactiveShare;
+    double paretoScale;
+    double cpuCap;
+    double ioCap;
+};
+
+/**
+ * Generates one chunk with arrival times relative to the start of the chunk
+ * The I/O draws come after the fields of a pure CPU process, so a workload
+ * without I/O is the same as before I/O bursts existed.
+ *
+ * @param store Destination with set(k, pid, arrival, burst, priority, queueType, sequence)
+ * @return Arrival time of the chunk's last process, relative to the chunk start
+ */
+template <typename Store>
+static long long generateChunk(const GeneratorOptions& options, size_t chunk, size_t count, Store store) {
+    ProcessSampler sampler(options, chunk);
+    long long arrival = 0;
+    int firstPid = (int)(chunk * CHUNK_SIZE) + 1;
+    vector<int> sequence(2 * options.ioBursts + 1);
+    for (size_t k = 0; k < count; k++) {
+        arrival += sampler.interarrival();
+        int burst = sampler.burst();
+        int priority = sampler.priority();
+        QueueType queueType = sampler.queueType();
+        sequence[0] = burst;
+        for (size_t b = 1; b < sequence.size(); b += 2) {
+            sequence[b] = sampler.ioBurst();
+            sequence[b + 1] = sampler.burst();
+        }
+        store.set(k, firstPid + (int)k, (int)min(arrival, (long long)INT_MAX), burst, priority, queueType, sequence);
+    }
+    return arrival;
+}
+
+// Writes a chunk into a ProcessTable slice (its burst sequences at fixed offsets when there is I/O)
+struct TableStore {
+    ProcessTable* table;
+    size_t first;
+
+    void set(size_t k, int pid, int arrival, int burst, int priority, QueueType queueType, const vector<int>& sequence) {
+        size_t i = first + k;
+        table->pid[i] = pid;
+        table->arrivalTime[i] = arrival;
+        table->burstTime[i] = burst;
+        table->priority[i] = priority;
+        table->queueType[i] = queueType;
+        if (sequence.size() > 1) {
+            int cpu = 0, io = 0;
+            for (size_t b = 0; b < sequence.size(); b++)
+                (b % 2 == 0 ? cpu : io) += sequence[b];
+            copy(sequence.begin(), sequence.end(), table->bursts.begin() + i * sequence.size());
+            table->burstTime[i] = cpu;
+            table->ioTime[i] = io;
+        }
+    }
+};
+
+// Writes a chunk into binary workload records (pure CPU only, see generateWorkloadFile)
+struct RecordStore {
+    WorkloadRecord* records;
+
+    void set(size_t k, int pid, int arrival, int burst, int priority, QueueType queueType, const vector<int>&) {
+        WorkloadRecord record = { pid, arrival, burst, priority, queueType };
+        records[k] = record;
+    }
+};
+
+static size_t chunkLength(size_t total, size_t chunk) {
+    return min(CHUNK_SIZE, total - chunk * CHUNK_SIZE);
+}
+
+static const char* OVERFLOW_ERROR = "arrival times exceed the int range; lower the process count or the mean interarrival time";
+static const char* WORK_OVERFLOW_ERROR = "the last arrival plus all CPU and I/O time exceeds the int range of the simulated clock; "
+    "lower the process count or the mean burst and I/O times";
+
+// Expected last arrival plus all CPU and I/O time (see ProcessTable::makespanBound)
+static double expectedMakespanBound(const GeneratorOptions& o) {
+    double burst = o.bursts == BIMODAL_BURSTS ? (1.0 - o.longFraction) * o.meanBurst + o.longFraction * o.longBurst : o.meanBurst;
+    return o.count * (o.meanInterarrival + (o.ioBursts + 1) * burst + o.ioBursts * o.meanIo);
+}
+
+bool validateGeneratorOptions(const GeneratorOptions& o, string& error) {
+    if (o.count == 0 || o.count > (size_t)INT_MAX)
+        error = "process count must be between 1 and " + to_string(INT_MAX);
+    else if (!(o.meanInterarrival >= 0.0))
+        error = "mean interarrival time must not be negative";
+    else if (!(o.meanClusterSize >= 1.0))
+        error = "mean cluster size must be at least 1";
+    else if (!(o.meanBurst >= 1.0))
+        error = "mean burst time must be at least 1";
+    else if (!(o.paretoShape > 1.0))
+        error = "Pareto shape must be greater than 1";
+    else if (!(o.longBurst >= 1.0))
+        error = "long burst mean must be at least 1";
+    else if (!(o.longFraction >= 0.0 && o.longFraction <= 1.0))
+        error = "long burst fraction must be between 0 and 1";
+    else if (o.ioBursts < 0 || o.ioBursts > MAX_IO_BURSTS)
+        error = "I/O bursts per process must be between 0 and " + to_string(MAX_IO_BURSTS);
+    else if (o.ioBursts > 0 && o.count > (size_t)INT_MAX / (2 * o.ioBursts + 1))
+        error = "too many bursts in total; lower the process count or the I/O bursts per process";
+    else if (!(o.meanIo >= 1.0))
+        error = "mean I/O time must be at least 1";
+    else if (expectedMakespanBound(o) > INT_MAX)
+        error = WORK_OVERFLOW_ERROR;
+    else if (o.priorityLevels <= 0)
+        error = "priority levels must be positive";
+    else if (!(o.queueMix[0] >= 0.0 && o.queueMix[1] >= 0.0 && o.queueMix[2] >= 0.0)
+        || !(o.queueMix[0] + o.queueMix[1] + o.queueMix[2] > 0.0))
+        error = "queue mix weights must be non-negative and not all zero";
+    else
+        return true;
+    return false;
+}
+
+// Runs task(c) for every c in [0, count) on a pool and waits for all of them
+struct PoolRunner {
+    ThreadPool& pool;
+
+    template <typename Task>
+    void operator()(size_t count, Task task) {
+        for (size_t c = 0; c < count; c++)
+            pool.submit([task, c]() { task(c); });
+        pool.wait();
+    }
+};
+
+// Runs task(c) for every c in [0, count) on the calling thread
+struct SerialRunner {
+    template <typename Task>
+    void operator()(size_t count, Task task) {
+        for (size_t c = 0; c < count; c++)
+            task(c);
+    }
+};
+
+// Body of both generateWorkload overloads; run decides where the chunks are generated
+template <typename Runner>
+static bool fillTable(const GeneratorOptions& options, ProcessTable& table, Runner run, string& error) {
+    if (!validateGeneratorOptions(options, error))
+        return false;
+
+    size_t n = options.count;
+    table.clear();
+    table.resize(n);
+    if (options.ioBursts > 0) {
+        // Every process has the same number of bursts, so the offsets are known upfront
+        size_t length = 2 * (size_t)options.ioBursts + 1;
+        table.bursts.resize(n * length);
+        table.ioTime.resize(n);
+        table.burstStart.resize(n + 1);
+        for (size_t i = 0; i <= n; i++)
+            table.burstStart[i] = (int)(i * length);
+    }
+    size_t chunks = (n + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    // Pass 1: every chunk on its own, arrival times relative to the chunk
+    vector<long long> chunkSpan(chunks);
+    run(chunks, [&options, &table, &chunkSpan, n](size_t c) {
+        chunkSpan[c] = generateChunk(options, c, chunkLength(n, c), TableStore{ &table, c * CHUNK_SIZE });
+    });
+
+    // Chunk start times are the running sum of the spans before them
+    vector<long long> chunkStart(chunks);
+    long long start = 0;
+    for (size_t c = 0; c < chunks; c++) {
+        chunkStart[c] = start;
+        start += chunkSpan[c];
+    }
+    if (start > INT_MAX) {
+        table.clear();
+        error = OVERFLOW_ERROR;
+        return false;
+    }
+
+    // Pass 2: shift every chunk to its start time (the first one starts at 0)
+    run(chunks, [&table, &chunkStart, n](size_t c) {
+        if (c == 0)
+            return;
+        int offset = (int)chunkStart[c];
+        int* arrival = table.arrivalTime.data() + c * CHUNK_SIZE;
+        size_t count = chunkLength(n, c);
+        for (size_t k = 0; k < count; k++)
+            arrival[k] += offset;
+    });
+
+    // The expectation passed validation, but the draws can still overshoot it
+    if (table.makespanBound() > INT_MAX) {
+        table.clear();
+        error = WORK_OVERFLOW_ERROR;
+        return false;
+    }
+    return true;
+}
+
+bool generateWorkload(const GeneratorOptions& options, ProcessTable& table, ThreadPool& pool, string& error) {
+    return fillTable(options, table, PoolRunner{ pool }, error);
+}
+
+bool generateWorkload(const GeneratorOptions& options, ProcessTable& table, string& error) {
+    return fillTable(options, table, SerialRunner(), error);
+}
+
+bool generateWorkloadFile(const GeneratorOptions& options, const string& path, ThreadPool& pool, string& error) {
+    if (!validateGeneratorOptions(options, error))
+        return false;
+    if (options.ioBursts > 0) {
+        error = "the binary workload format has no I/O bursts";
+        return false;
+    }
+
+    FILE* file = openFile(path, "wb");
+    if (!file) {
+        error = "cannot create " + path;
+        return false;
+    }
+
+    size_t n = options.count;
+    WorkloadHeader header;
+    memcpy(header.magic, WORKLOAD_MAGIC, sizeof(WORKLOAD_MAGIC));
+    header.version = WORKLOAD_VERSION;
+    header.recordSize = sizeof(WorkloadRecord);
+    header.count = n;
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    if (!ok)
+        error = "write error in " + path;
+
+    // A few chunks per thread are generated in parallel, then written in order
+    size_t chunks = (n + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    size_t batchChunks = (size_t)pool.size() * 4;
+    vector<WorkloadRecord> buffer(min(chunks, batchChunks) * CHUNK_SIZE);
+    vector<long long> chunkSpan(batchChunks);
+    long long start = 0;
+    long long work = 0;   // CPU time written so far
+
+    for (size_t firstChunk = 0; ok && firstChunk < chunks; firstChunk += batchChunks) {
+        size_t lastChunk = min(chunks, firstChunk + batchChunks);
+        for (size_t c = firstChunk; c < lastChunk; c++) {
+            size_t slot = c - firstChunk;
+            pool.submit([&options, &buffer, &chunkSpan, n, c, slot]() {
+                chunkSpan[slot] = generateChunk(options, c, chunkLength(n, c), RecordStore{ buffer.data() + slot * CHUNK_SIZE });
+            });
+        }
+        pool.wait();
+
+        for (size_t c = firstChunk; ok && c < lastChunk; c++) {
+            size_t slot = c - firstChunk;
+            size_t count = chunkLength(n, c);
+            if (start + chunkSpan[slot] > INT_MAX) {
+                error = OVERFLOW_ERROR;
+                ok = false;
+                break;
+            }
+            WorkloadRecord* records = buffer.data() + slot * CHUNK_SIZE;
+            for (size_t k = 0; k < count; k++) {
+                records[k].arrivalTime += (int)start;
+                work += records[k].burstTime;
+            }
+            start += chunkSpan[slot];
+            if (records[count - 1].arrivalTime + work > INT_MAX) {
+                error = WORK_OVERFLOW_ERROR;
+                ok = false;
+                break;
+            }
+
+            if (fwrite(records, sizeof(WorkloadRecord), count, file) != count) {
+                error = "write error in " + path;
+                ok = false;
+            }
+        }
+    }
+
+    if (fclose(file) != 0 && ok) {
+        error = "write error in " + path;
+        ok = false;
+    }
+    if (!ok)
+        remove(path.c_str());
+    return ok;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "ProcessTable.h"
+#include "ThreadPool.h"
+
+/**
+ * SplitMix64 generator: tiny state, so every chunk gets its own stream cheaply
+ */
+struct SplitMix64 {
+    uint64_t state;
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, 1)
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+enum ArrivalPattern { POISSON_ARRIVALS, BURSTY_ARRIVALS };
+enum BurstDistribution { UNIFORM_BURSTS, EXPONENTIAL_BURSTS, PARETO_BURSTS, BIMODAL_BURSTS };
+
+/**
+ * Parameters of a synthetic workload
+ * Times are in simulator time units; generated times are rounded to integers.
+ */
+struct GeneratorOptions {
+    size_t count = 1000;
+    uint64_t seed = 1;
+
+    // Arrivals
+    ArrivalPattern arrivals = POISSON_ARRIVALS;
+    double meanInterarrival = 10.0;   // long-run mean gap between arrivals
+    double meanClusterSize = 20.0;    // bursty: mean arrivals per cluster
+
+    // Burst times
+    BurstDistribution bursts = EXPONENTIAL_BURSTS;
+    double meanBurst = 8.0;           // uniform, exponential and Pareto mean, bimodal short mode mean
+    double paretoShape = 1.5;         // Pareto tail index (> 1); smaller means heavier tail
+    double longBurst = 200.0;         // bimodal long mode mean
+    double longFraction = 0.1;        // bimodal share of long bursts
+
+    // I/O: each process alternates ioBursts + 1 CPU bursts (drawn as above)
+    // with ioBursts exponential I/O bursts; 0 gives pure CPU processes
+    int ioBursts = 0;
+    double meanIo = 20.0;
+
+    // Priorities are uniform over 0 .. priorityLevels - 1
+    int priorityLevels = 8;
+
+    // Relative weights of SYSTEM, INTERACTIVE and BATCH processes
+    double queueMix[3] = { 1.0, 1.0, 1.0 };
+};
+
+/**
+ * Checks that the options describe a valid workload
+ *
+ * @return false (with error set) on a bad parameter
+ */
+bool validateGeneratorOptions(const GeneratorOptions& options, std::string& error);
+
+/**
+ * Generates a workload straight into a ProcessTable, sorted by arrival time
+ *
+ * Work is split into fixed-size chunks, each drawing from its own RNG stream
+ * derived from the seed and the chunk number, so the workload only depends on
+ * the options: not on the pool size nor on the output target.
+ *
+ * @param options Workload parameters
+ * @param table Receives the processes (pids 1..count)
+ * @param pool Pool generating the chunks
+ * @param error Receives a description of the problem on failure
+ * @return true on success
+ */
+bool generateWorkload(const GeneratorOptions& options, ProcessTable& table, ThreadPool& pool, std::string& error);
+
+// Same workload, generated on the calling thread (for tasks that already run one workload each)
+bool generateWorkload(const GeneratorOptions& options, ProcessTable& table, std::string& error);
+
+/**
+ * Generates a workload straight into a binary workload file
+ * Same processes as generateWorkload; memory stays bounded by a few chunks
+ * per pool thread whatever the count. The binary format has no I/O bursts,
+ * so options.ioBursts must be 0.
+ *
+ * @return true on success
+ */
+bool generateWorkloadFile(const GeneratorOptions& options, const std::string& path, ThreadPool& pool, std::string& error);
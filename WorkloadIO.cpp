@@ -0,0 +1,431 @@
+#include "WorkloadIO.h"
+#include "Utils.h"
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <algorithm>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static const size_t READ_BUFFER_SIZE = 1 << 20;
+
+static bool isSeparator(char c) {
+    return c == ',' || c == '\t' || c == ';' || c == ' ' || c == '\r';
+}
+
+/**
+ * Parses one signed integer field and skips the separators after it
+ *
+ * @param slash If not null, a '/' may follow the number: it is consumed and
+ *              *slash set, for the next number of a burst sequence
+ * @return false if the field is missing or not a number
+ */
+static bool parseField(const char*& cursor, const char* end, int& value, bool* slash = nullptr) {
+    bool negative = false;
+    if (cursor < end && (*cursor == '-' || *cursor == '+')) {
+        negative = (*cursor == '-');
+        cursor++;
+    }
+    if (cursor == end || *cursor < '0' || *cursor > '9')
+        return false;
+
+    long long result = 0;
+    while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+        result = result * 10 + (*cursor - '0');
+        if (result > 2147483647LL)
+            return false;
+        cursor++;
+    }
+    value = (int)(negative ? -result : result);
+    if (slash) {
+        *slash = cursor < end && *cursor == '/';
+        if (*slash) {
+            cursor++;
+            return true;
+        }
+    }
+    if (cursor < end && !isSeparator(*cursor))
+        return false;
+    while (cursor < end && isSeparator(*cursor))
+        cursor++;
+    return true;
+}
+
+/**
+ * Parses the burst field: one CPU burst, or CPU and I/O bursts alternating
+ * as cpu/io/cpu/... (sequence receives every number when there is a '/')
+ *
+ * @return false if a number is missing or malformed
+ */
+static bool parseBurstField(const char*& cursor, const char* end, int& burst, vector<int>& sequence) {
+    sequence.clear();
+    bool slash = false;
+    if (!parseField(cursor, end, burst, &slash))
+        return false;
+    if (!slash)
+        return true;
+    sequence.push_back(burst);
+    int value;
+    do {
+        if (!parseField(cursor, end, value, &slash))
+            return false;
+        sequence.push_back(value);
+    } while (slash);
+    return true;
+}
+
+LineReader::LineReader() : file(nullptr), begin(0), end(0), eof(false) {}
+
+LineReader::~LineReader() {
+    if (file)
+        fclose(file);
+}
+
+bool LineReader::open(const string& path, string& error) {
+    file = openFile(path, "rb");
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    filePath = path;
+    buffer.resize(READ_BUFFER_SIZE);
+    return true;
+}
+
+bool LineReader::next(const char*& lineBegin, const char*& lineEnd) {
+    if (!file)
+        return false;
+    while (true) {
+        char* data = buffer.data();
+        char* newline = (char*)memchr(data + begin, '\n', end - begin);
+        if (newline) {
+            lineBegin = data + begin;
+            lineEnd = newline;
+            begin = newline - data + 1;
+            return true;
+        }
+        if (eof) {
+            if (begin == end)
+                return false;
+            // Last line without a trailing newline
+            lineBegin = data + begin;
+            lineEnd = data + end;
+            begin = end;
+            return true;
+        }
+        refill();
+    }
+}
+
+// Moves the partial line to the front and reads more data behind it
+void LineReader::refill() {
+    size_t pending = end - begin;
+    if (pending == buffer.size())
+        buffer.resize(buffer.size() * 2); // a single line longer than the buffer
+    memmove(buffer.data(), buffer.data() + begin, pending);
+    begin = 0;
+    end = pending;
+    size_t got = fread(buffer.data() + end, 1, buffer.size() - end, file);
+    end += got;
+    if (got == 0)
+        eof = true;
+}
+
+TextWorkloadReader::TextWorkloadReader() : lineNumber(0), seenData(false) {}
+
+bool TextWorkloadReader::open(const string& workloadPath, string& error) {
+    return lines.open(workloadPath, error);
+}
+
+bool TextWorkloadReader::next(Process& process) {
+    const char* lineBegin;
+    const char* lineEnd;
+
+    while (!failed() && lines.next(lineBegin, lineEnd)) {
+        lineNumber++;
+
+        const char* cursor = lineBegin;
+        while (cursor < lineEnd && isSeparator(*cursor))
+            cursor++;
+        if (cursor == lineEnd || *cursor == '#')
+            continue;
+
+        int fields[5] = { 0, 0, 0, 0, BATCH };
+        int count = 0;
+        while (count < 5 && cursor < lineEnd && (count == 2
+                ? parseBurstField(cursor, lineEnd, fields[count], burstSequence)
+                : parseField(cursor, lineEnd, fields[count])))
+            count++;
+
+        if (cursor != lineEnd || count < 3) {
+            // A non-numeric first line is a column header
+            if (!seenData && count == 0) {
+                seenData = true;
+                continue;
+            }
+            fail("expected pid, arrival, burst [, priority [, queueType]]");
+            return false;
+        }
+        seenData = true;
+
+        if (fields[1] < 0 || fields[2] <= 0 || fields[4] < SYSTEM || fields[4] > BATCH) {
+            fail("arrival must be non-negative, burst positive and queue type 0, 1 or 2");
+            return false;
+        }
+
+        process = Process(fields[0], fields[1], fields[2], fields[3], static_cast<QueueType>(fields[4]));
+        if (!burstSequence.empty()) {
+            long long cpu = 0, io = 0;
+            bool valid = burstSequence.size() % 2 == 1;
+            for (size_t k = 0; valid && k < burstSequence.size(); k++) {
+                valid = burstSequence[k] > 0;
+                (k % 2 == 0 ? cpu : io) += burstSequence[k];
+            }
+            if (!valid || cpu > INT_MAX || io > INT_MAX) {
+                fail("a burst sequence alternates positive CPU and I/O bursts, starting and ending with CPU (cpu/io/cpu)");
+                return false;
+            }
+            process.setBursts(burstSequence);
+        }
+        return true;
+    }
+
+    if (!failed() && lines.readError())
+        errorMessage = "read error in " + lines.path();
+    return false;
+}
+
+void TextWorkloadReader::fail(const string& message) {
+    errorMessage = lines.path() + ":" + to_string(lineNumber) + ": " + message;
+}
+
+bool loadTextWorkload(const string& path, vector<Process>& processes, string& error) {
+    TextWorkloadReader reader;
+    if (!reader.open(path, error))
+        return false;
+
+    Process process(0, 0, 0, 0, BATCH);
+    while (reader.next(process))
+        processes.push_back(process);
+
+    if (reader.failed()) {
+        error = reader.error();
+        return false;
+    }
+    return true;
+}
+
+MappedWorkload::MappedWorkload() : mapping(nullptr), mappingSize(0), records(nullptr), count(0) {}
+
+MappedWorkload::~MappedWorkload() {
+    close();
+}
+
+/**
+ * Maps the whole file read-only
+ * The OS pages records in on demand, so opening is O(1) regardless of size.
+ */
+bool MappedWorkload::open(const string& path, string& error) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = "cannot open " + path;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        error = "cannot read the size of " + path;
+        CloseHandle(file);
+        return false;
+    }
+    mappingSize = (size_t)fileSize.QuadPart;
+    if (mappingSize >= sizeof(WorkloadHeader)) {
+        HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (fileMapping) {
+            mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(fileMapping); // the view keeps the mapping alive
+        }
+    }
+    CloseHandle(file);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        error = "cannot read the size of " + path;
+        ::close(fd);
+        return false;
+    }
+    mappingSize = (size_t)info.st_size;
+    if (mappingSize >= sizeof(WorkloadHeader)) {
+        void* view = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+        if (view != MAP_FAILED) {
+            mapping = view;
+            madvise(view, mappingSize, MADV_SEQUENTIAL); // schedulers read in arrival order
+        }
+    }
+    ::close(fd); // the mapping stays valid after the descriptor is closed
+#endif
+
+    if (!mapping) {
+        error = path + " is too small or cannot be mapped";
+        mappingSize = 0;
+        return false;
+    }
+
+    const WorkloadHeader* header = static_cast<const WorkloadHeader*>(mapping);
+    if (memcmp(header->magic, WORKLOAD_MAGIC, sizeof(WORKLOAD_MAGIC)) != 0 ||
+        header->version != WORKLOAD_VERSION || header->recordSize != sizeof(WorkloadRecord)) {
+        error = path + " is not a version " + to_string(WORKLOAD_VERSION) + " binary workload";
+        close();
+        return false;
+    }
+    if (header->count > (mappingSize - sizeof(WorkloadHeader)) / sizeof(WorkloadRecord)) {
+        error = path + " is truncated";
+        close();
+        return false;
+    }
+
+    records = reinterpret_cast<const WorkloadRecord*>(static_cast<const char*>(mapping) + sizeof(WorkloadHeader));
+    count = (size_t)header->count;
+    filePath = path;
+    return true;
+}
+
+void MappedWorkload::close() {
+    if (mapping) {
+#ifdef _WIN32
+        UnmapViewOfFile(mapping);
+#else
+        munmap(mapping, mappingSize);
+#endif
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    records = nullptr;
+    count = 0;
+    filePath.clear();
+}
+
+bool MappedWorkload::checkRecord(size_t i, string& error) const {
+    const WorkloadRecord& r = records[i];
+    const char* problem = nullptr;
+    if (r.arrivalTime < 0 || r.burstTime <= 0 || r.queueType < SYSTEM || r.queueType > BATCH)
+        problem = "arrival must be non-negative, burst positive and queue type 0, 1 or 2";
+    else if (i > 0 && r.arrivalTime < records[i - 1].arrivalTime)
+        problem = "records are not sorted by arrival time";
+    if (!problem)
+        return true;
+    error = filePath + ": record " + to_string(i + 1) + ": " + problem;
+    return false;
+}
+
+bool isBinaryWorkload(const string& path) {
+    FILE* file = openFile(path, "rb");
+    if (!file)
+        return false;
+    char magic[sizeof(WORKLOAD_MAGIC)];
+    bool binary = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+        memcmp(magic, WORKLOAD_MAGIC, sizeof(magic)) == 0;
+    fclose(file);
+    return binary;
+}
+
+bool saveBinaryWorkload(const string& path, vector<Process>& processes, string& error) {
+    // Records have a single burst field
+    for (const Process& p : processes) {
+        if (!p.bursts.empty()) {
+            error = "the binary workload format has no I/O bursts (pid " + to_string(p.pid) + ")";
+            return false;
+        }
+    }
+
+    // Same ordering as the text path, so both formats give identical results
+    sortByArrivalTime(processes);
+
+    FILE* file = openFile(path, "wb");
+    if (!file) {
+        error = "cannot create " + path;
+        return false;
+    }
+
+    WorkloadHeader header;
+    memcpy(header.magic, WORKLOAD_MAGIC, sizeof(WORKLOAD_MAGIC));
+    header.version = WORKLOAD_VERSION;
+    header.recordSize = sizeof(WorkloadRecord);
+    header.count = processes.size();
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    // Write records in large chunks
+    const size_t CHUNK = 1 << 16;
+    vector<WorkloadRecord> chunk;
+    chunk.reserve(CHUNK);
+    for (size_t i = 0; ok && i < processes.size(); i += CHUNK) {
+        chunk.clear();
+        size_t last = min(processes.size(), i + CHUNK);
+        for (size_t j = i; j < last; j++) {
+            const Process& p = processes[j];
+            WorkloadRecord record = { p.pid, p.arrivalTime, p.burstTime, p.priority, p.queueType };
+            chunk.push_back(record);
+        }
+        ok = fwrite(chunk.data(), sizeof(WorkloadRecord), chunk.size(), file) == chunk.size();
+    }
+
+    if (fclose(file) != 0)
+        ok = false;
+    if (!ok)
+        error = "write error in " + path;
+    return ok;
+}
+
+bool saveTextWorkload(const string& path, const ProcessTable& table, string& error) {
+    FILE* file = openFile(path, "w");
+    if (!file) {
+        error = "cannot create " + path;
+        return false;
+    }
+
+    fputs("pid,arrival,burst,priority,queue_type\n", file);
+    for (size_t i = 0; i < table.size(); i++) {
+        fprintf(file, "%d,%d,", table.pid[i], table.arrivalTime[i]);
+        if (table.hasIo()) {
+            for (int k = table.burstStart[i]; k < table.burstStart[i + 1]; k++)
+                fprintf(file, k == table.burstStart[i] ? "%d" : "/%d", table.bursts[k]);
+        }
+        else {
+            fprintf(file, "%d", table.burstTime[i]);
+        }
+        fprintf(file, ",%d,%d\n", table.priority[i], (int)table.queueType[i]);
+    }
+
+    bool ok = !ferror(file);
+    if (fclose(file) != 0)
+        ok = false;
+    if (!ok)
+        error = "write error in " + path;
+    return ok;
+}
+
+bool convertTextToBinary(const string& textPath, const string& binaryPath, string& error) {
+    vector<Process> processes;
+    if (!loadTextWorkload(textPath, processes, error))
+        return false;
+    return saveBinaryWorkload(binaryPath, processes, error);
+}
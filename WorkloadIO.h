@@ -0,0 +1,225 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include "Process.h"
+#include "ProcessTable.h"
+
+// Binary workload file layout (native little-endian):
+//   WorkloadHeader, then header.count WorkloadRecords sorted by arrival time
+const char WORKLOAD_MAGIC[8] = { 'C', 'P', 'U', 'S', 'W', 'L', 'D', '\0' };
+const uint32_t WORKLOAD_VERSION = 1;
+
+struct WorkloadHeader {
+    char magic[8];         // WORKLOAD_MAGIC
+    uint32_t version;      // WORKLOAD_VERSION
+    uint32_t recordSize;   // sizeof(WorkloadRecord)
+    uint64_t count;        // number of records that follow
+};
+
+// One process in a binary workload, fixed width
+struct WorkloadRecord {
+    int32_t pid;
+    int32_t arrivalTime;
+    int32_t burstTime;
+    int32_t priority;
+    int32_t queueType;     // QueueType value
+
+    Process toProcess() const {
+        return Process(pid, arrivalTime, burstTime, priority, static_cast<QueueType>(queueType));
+    }
+};
+
+static_assert(sizeof(WorkloadHeader) == 24, "WorkloadHeader must stay 24 bytes");
+static_assert(sizeof(WorkloadRecord) == 20, "WorkloadRecord must stay 20 bytes");
+
+/**
+ * Read-only memory-mapped view of a binary workload file
+ * Records are read straight from the mapping, nothing is copied.
+ * Records are sorted by arrival time, as the schedulers expect.
+ */
+class MappedWorkload {
+public:
+    MappedWorkload();
+    ~MappedWorkload();
+
+    /**
+     * Maps a binary workload file and validates its header
+     *
+     * @param path Path of the binary workload
+     * @param error Receives a description of the problem on failure
+     * @return true on success
+     */
+    bool open(const std::string& path, std::string& error);
+    void close();
+
+    /**
+     * Checks record i with the rules of the text reader, and that it does not
+     * arrive before record i - 1. Opening only reads the header, so callers
+     * check each record as they go through the file.
+     *
+     * @param error Receives "<path>: record <i + 1>: <problem>" on failure
+     * @return false if the arrival is negative or decreasing, the burst is not
+     *         positive or the queue type is not 0, 1 or 2
+     */
+    bool checkRecord(size_t i, std::string& error) const;
+
+    size_t size() const { return count; }
+    const WorkloadRecord& operator[](size_t i) const { return records[i]; }
+    const WorkloadRecord* begin() const { return records; }
+    const WorkloadRecord* end() const { return records + count; }
+
+private:
+    MappedWorkload(const MappedWorkload&);
+    MappedWorkload& operator=(const MappedWorkload&);
+
+    void* mapping;
+    size_t mappingSize;
+    const WorkloadRecord* records;
+    size_t count;
+    std::string filePath;
+};
+
+/**
+ * Reads a text file line by line through a large fixed buffer
+ *
+ * Lines are handed out as ranges into the buffer, valid until the next call,
+ * so reading allocates nothing once the buffer holds the longest line.
+ */
+class LineReader {
+public:
+    LineReader();
+    ~LineReader();
+
+    /**
+     * Opens a file for reading
+     *
+     * @param path Path of the file
+     * @param error Receives a description of the problem on failure
+     * @return true on success
+     */
+    bool open(const std::string& path, std::string& error);
+
+    /**
+     * Hands out the next line (without its '\n') as a [begin, end) range
+     *
+     * @return false once the file is exhausted (or on a read error, see readError())
+     */
+    bool next(const char*& lineBegin, const char*& lineEnd);
+
+    bool readError() const { return file && ferror(file); }
+    const std::string& path() const { return filePath; }
+
+private:
+    LineReader(const LineReader&);
+    LineReader& operator=(const LineReader&);
+
+    void refill();
+
+    FILE* file;
+    std::string filePath;
+    std::vector<char> buffer;
+    size_t begin;
+    size_t end;
+    bool eof;
+};
+
+/**
+ * Streams processes from a text workload (CSV, TSV or whitespace separated)
+ *
+ * Each line holds: pid, arrivalTime, burstTime [, priority [, queueType]]
+ * Priority defaults to 0 and queue type to BATCH when omitted. The burst
+ * field may also be a CPU/I-O sequence, cpu/io/cpu/... (odd length, e.g.
+ * 5/20/3 for 5 units of CPU, 20 of I/O and 3 more of CPU).
+ * Blank lines and lines starting with '#' are ignored, and a non-numeric
+ * first line is treated as a header.
+ *
+ * The file is read through a large fixed buffer and fields are parsed in
+ * place, so reading a record allocates nothing.
+ */
+class TextWorkloadReader {
+public:
+    TextWorkloadReader();
+
+    /**
+     * Opens a text workload for reading
+     *
+     * @param path Path of the workload file
+     * @param error Receives a description of the problem on failure
+     * @return true on success
+     */
+    bool open(const std::string& path, std::string& error);
+
+    /**
+     * Reads the next process in file order
+     *
+     * @param process Receives the parsed process
+     * @return false at end of file or on a malformed line (see failed())
+     */
+    bool next(Process& process);
+
+    bool failed() const { return !errorMessage.empty(); }
+    const std::string& error() const { return errorMessage; }
+
+private:
+    TextWorkloadReader(const TextWorkloadReader&);
+    TextWorkloadReader& operator=(const TextWorkloadReader&);
+
+    void fail(const std::string& message);
+
+    LineReader lines;
+    long long lineNumber;
+    bool seenData;
+    std::vector<int> burstSequence;   // reused for the lines with I/O bursts
+    std::string errorMessage;
+};
+
+/**
+ * Loads a whole text workload (see TextWorkloadReader) into processes
+ *
+ * @param path Path of the workload file
+ * @param processes Receives the parsed processes (appended, in file order)
+ * @param error Receives a description of the first problem found
+ * @return true on success, false if the file cannot be read or is malformed
+ */
+bool loadTextWorkload(const std::string& path, std::vector<Process>& processes, std::string& error);
+
+/**
+ * Checks whether a file starts with the binary workload magic
+ *
+ * @param path Path of the workload file
+ * @return true for binary workloads, false for text or unreadable files
+ */
+bool isBinaryWorkload(const std::string& path);
+
+/**
+ * Writes processes as a binary workload, sorted by arrival time
+ * Processes with I/O bursts cannot be stored (the records hold one burst).
+ *
+ * @param path Path of the binary workload to create
+ * @param processes Processes to write (sorted by arrival time in place)
+ * @param error Receives a description of the problem on failure
+ * @return true on success
+ */
+bool saveBinaryWorkload(const std::string& path, std::vector<Process>& processes, std::string& error);
+
+/**
+ * Writes a table as a text workload that loadTextWorkload reads back
+ * One CSV line per process, in table order, after a header line; processes
+ * with I/O get their burst sequence (cpu/io/cpu/...).
+ *
+ * @param path Path of the text workload to create
+ * @param table Processes to write
+ * @param error Receives a description of the problem on failure
+ * @return true on success
+ */
+bool saveTextWorkload(const std::string& path, const ProcessTable& table, std::string& error);
+
+/**
+ * Converts a text workload (see loadTextWorkload) to the binary format
+ *
+ * @return true on success
+ */
+bool convertTextToBinary(const std::string& textPath, const std::string& binaryPath, std::string& error);
@@ -0,0 +1,95 @@
+/**
+ * Scan bandwidth benchmark: Process vector (array of structs) vs ProcessTable
+ *
+ * Times the "shortest remaining time among arrived processes" scan that the
+ * tick-based preemptive schedulers used to run on every time unit. The AoS
+ * version drags the full Process struct through the cache; the SoA
+ * version only streams the arrival and remaining-time arrays (8 bytes per
+ * process).
+ *
+ * Build (from the repository root):
+ *   g++ -O2 -I. -o scan_benchmark benchmarks/ScanBenchmark.cpp ProcessTable.cpp
+ */
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Process.h"
+#include "ProcessTable.h"
+
+using namespace std;
+
+// Keeps the compiler from discarding the scan results
+static volatile int sink;
+
+static int scanProcesses(const vector<Process>& processes, int currentTime) {
+    int idx = -1;
+    int minRemaining = INT_MAX;
+    for (size_t i = 0; i < processes.size(); i++) {
+        const Process& p = processes[i];
+        if (p.remainingTime > 0 && p.arrivalTime <= currentTime && p.remainingTime < minRemaining) {
+            minRemaining = p.remainingTime;
+            idx = (int)i;
+        }
+    }
+    return idx;
+}
+
+static int scanTable(const ProcessTable& table, const ScheduleResult& result, int currentTime) {
+    const int* arrival = table.arrivalTime.data();
+    const int* remaining = result.remainingTime.data();
+    int n = (int)table.size();
+    int idx = -1;
+    int minRemaining = INT_MAX;
+    for (int i = 0; i < n; i++) {
+        if (remaining[i] > 0 && arrival[i] <= currentTime && remaining[i] < minRemaining) {
+            minRemaining = remaining[i];
+            idx = i;
+        }
+    }
+    return idx;
+}
+
+template <typename Scan>
+static double nsPerProcess(size_t n, int repetitions, Scan scan) {
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; r++)
+        sink = scan(r);
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    return ns / ((double)n * repetitions);
+}
+
+int main() {
+    mt19937 rng(12345);
+    printf("%12s %14s %14s %12s %12s %8s\n", "processes", "AoS ns/proc", "SoA ns/proc", "AoS GB/s", "SoA GB/s", "speedup");
+
+    for (size_t n = 1000; n <= 10000000; n *= 10) {
+        vector<Process> processes;
+        processes.reserve(n);
+        int arrival = 0;
+        for (size_t i = 0; i < n; i++) {
+            arrival += (int)(rng() % 4);
+            processes.emplace_back((int)i, arrival, 1 + (int)(rng() % 1000), (int)(rng() % 140), static_cast<QueueType>(rng() % 3));
+        }
+        ProcessTable table(processes);
+        ScheduleResult result;
+        result.reset(table);
+
+        // About 10^9 scanned processes per size
+        int repetitions = (int)(1000000000 / n);
+        if (repetitions < 3)
+            repetitions = 3;
+        int horizon = arrival;
+
+        double aos = nsPerProcess(n, repetitions, [&](int r) { return scanProcesses(processes, horizon - r); });
+        double soa = nsPerProcess(n, repetitions, [&](int r) { return scanTable(table, result, horizon - r); });
+
+        double aosBytes = (double)sizeof(Process);
+        double soaBytes = 2.0 * sizeof(int);
+        printf("%12zu %14.3f %14.3f %12.2f %12.2f %7.2fx\n",
+            n, aos, soa, aosBytes / aos, soaBytes / soa, aos / soa);
+    }
+    return 0;
+}
@@ -0,0 +1,274 @@
+/**
+ * Scheduler scaling benchmark and regression gate
+ *
+ * Times every table-based algorithm on generated workloads of 10^2 to 10^7
+ * processes, once with uniform bursts and Poisson arrivals and once with
+ * Pareto (heavy-tailed) bursts and bursty arrivals. Reports, as JSON:
+ *   - ns_per_process: best wall time of the run divided by the process count
+ *   - peak_bytes: peak heap allocated by the run itself (result arrays and queues)
+ *   - steady_bytes: heap allocated by a run on a ScheduleResult reused from an
+ *     earlier run on the same table (0: repeated runs do not allocate)
+ *   - sim_per_wall_second: simulated time units covered per wall-clock second
+ *
+ * The run fails (exit code 1) when ns per process grows more than
+ * --max-growth times between 10^4 processes and the largest size, which is
+ * how an O(n^2) scan shows up, or when a result is more than --tolerance
+ * times slower than the same entry of a --baseline JSON file written by an
+ * earlier run.
+ *
+ * Build (from the repository root):
+ *   g++ -O2 -std=c++14 -pthread -I. -o scheduler_benchmark benchmarks/SchedulerBenchmark.cpp \
+ *       Scheduler.cpp ProcessTable.cpp WorkloadGenerator.cpp WorkloadIO.cpp ThreadPool.cpp Utils.cpp ResultSink.cpp Timeline.cpp \
+ *       QuantileSketch.cpp Checkpoint.cpp
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "ProcessTable.h"
+#include "Scheduler.h"
+#include "ThreadPool.h"
+#include "Utils.h"
+#include "WorkloadGenerator.h"
+
+using namespace std;
+
+/* ================= HEAP TRACKING ================= */
+
+// Every allocation carries its size in a header so deletes can be counted
+static const size_t HEADER = 16;
+static atomic<long long> liveBytes(0);
+static atomic<long long> peakBytes(0);
+
+static void* trackedAlloc(size_t size) {
+    char* block = (char*)malloc(size + HEADER);
+    if (!block)
+        throw bad_alloc();
+    *(size_t*)block = size;
+    long long live = liveBytes += (long long)size;
+    long long peak = peakBytes.load();
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live)) {}
+    return block + HEADER;
+}
+
+static void trackedFree(void* p) {
+    if (!p)
+        return;
+    char* block = (char*)p - HEADER;
+    liveBytes -= (long long)*(size_t*)block;
+    free(block);
+}
+
+void* operator new(size_t size) { return trackedAlloc(size); }
+void* operator new[](size_t size) { return trackedAlloc(size); }
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { trackedFree(p); }
+
+/* ================= BENCHMARK ================= */
+
+struct Workload {
+    const char* name;
+    GeneratorOptions options;
+};
+
+struct Measurement {
+    string algorithm;
+    string workload;
+    size_t processes;
+    double nsPerProcess;
+    long long peakBytes;
+    long long steadyBytes;
+    double simPerWallSecond;
+};
+
+static const size_t GROWTH_REFERENCE_SIZE = 10000;
+
+static vector<Workload> makeWorkloads() {
+    Workload uniform = { "uniform", GeneratorOptions() };
+    uniform.options.arrivals = POISSON_ARRIVALS;
+    uniform.options.bursts = UNIFORM_BURSTS;
+
+    Workload heavy = { "heavy-tailed", GeneratorOptions() };
+    heavy.options.arrivals = BURSTY_ARRIVALS;
+    heavy.options.bursts = PARETO_BURSTS;
+
+    // Mean burst 8 against a mean interarrival of 10: 80% CPU load
+    return { uniform, heavy };
+}
+
+/**
+ * Times one algorithm on one table
+ * An untimed warm-up run settles the allocator, then the run is repeated
+ * (at least 3 times, and up to ~10^6 scheduled processes in total) and the
+ * fastest repetition is reported. The warm-up result is then run again to
+ * measure steady-state allocation.
+ */
+static Measurement measure(int algo, const Workload& workload, const ProcessTable& table, int timeQuantum) {
+    size_t n = table.size();
+    int repetitions = (int)max<size_t>(3, min<size_t>(1000, 1000000 / n));
+    double bestNs = 1e300;
+    long long runPeak = 0;
+    int makespan = 0;
+
+    ScheduleResult warmUp;
+    runAlgorithm(algo, table, warmUp, timeQuantum);
+
+    for (int r = 0; r < repetitions; r++) {
+        long long before = liveBytes.load();
+        peakBytes = before;
+
+        auto start = chrono::steady_clock::now();
+        {
+            ScheduleResult result;
+            runAlgorithm(algo, table, result, timeQuantum);
+            makespan = *max_element(result.completionTime.begin(), result.completionTime.end());
+        }
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+
+        bestNs = min(bestNs, ns);
+        runPeak = max(runPeak, peakBytes.load() - before);
+    }
+
+    long long before = liveBytes.load();
+    peakBytes = before;
+    runAlgorithm(algo, table, warmUp, timeQuantum);
+    long long steadyBytes = peakBytes.load() - before;
+
+    Measurement m;
+    m.algorithm = ALGORITHM_TITLES[algo - 1];
+    m.workload = workload.name;
+    m.processes = n;
+    m.nsPerProcess = bestNs / n;
+    m.peakBytes = runPeak;
+    m.steadyBytes = steadyBytes;
+    m.simPerWallSecond = makespan / (bestNs * 1e-9);
+    return m;
+}
+
+/**
+ * Reads the results of an earlier run (one result object per line)
+ */
+static bool loadBaseline(const string& path, map<string, double>& baseline) {
+    FILE* file = openFile(path, "r");
+    if (!file)
+        return false;
+    char line[512];
+    while (fgets(line, sizeof(line), file)) {
+        char algorithm[128], workload[128];
+        size_t processes;
+        double ns;
+        if (sscanf(line, " {\"algorithm\":\"%127[^\"]\",\"workload\":\"%127[^\"]\",\"processes\":%zu,\"ns_per_process\":%lf",
+                algorithm, workload, &processes, &ns) == 4)
+            baseline[string(algorithm) + "/" + workload + "/" + to_string(processes)] = ns;
+    }
+    fclose(file);
+    return true;
+}
+
+static void printUsage() {
+    fprintf(stderr,
+        "Usage: scheduler_benchmark [--max-size <n>] [--quantum <n>] [--max-growth <x>]\n"
+        "                           [--baseline <json> [--tolerance <x>]]\n");
+}
+
+int main(int argc, char* argv[]) {
+    size_t maxSize = 10000000;
+    int timeQuantum = 4;
+    double maxGrowth = 10.0;
+    double tolerance = 1.5;
+    string baselinePath;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage();
+            return 2;
+        }
+        string value = argv[++i];
+        if (arg == "--max-size") maxSize = strtoull(value.c_str(), nullptr, 10);
+        else if (arg == "--quantum") timeQuantum = atoi(value.c_str());
+        else if (arg == "--max-growth") maxGrowth = atof(value.c_str());
+        else if (arg == "--tolerance") tolerance = atof(value.c_str());
+        else if (arg == "--baseline") baselinePath = value;
+        else {
+            printUsage();
+            return 2;
+        }
+    }
+    if (maxSize < 100 || timeQuantum <= 0) {
+        printUsage();
+        return 2;
+    }
+
+    map<string, double> baseline;
+    if (!baselinePath.empty() && !loadBaseline(baselinePath, baseline)) {
+        fprintf(stderr, "cannot read %s\n", baselinePath.c_str());
+        return 2;
+    }
+
+    vector<Measurement> results;
+    vector<string> regressions;
+    ThreadPool pool;
+
+    for (const Workload& workload : makeWorkloads()) {
+        // ns per process at the reference size, per algorithm
+        map<int, double> reference;
+
+        for (size_t n = 100; n <= maxSize; n *= 10) {
+            GeneratorOptions options = workload.options;
+            options.count = n;
+            ProcessTable table;
+            string error;
+            if (!generateWorkload(options, table, pool, error)) {
+                fprintf(stderr, "%s\n", error.c_str());
+                return 2;
+            }
+
+            for (int algo = 1; algo <= 7; algo++) {
+                Measurement m = measure(algo, workload, table, timeQuantum);
+                results.push_back(m);
+                fprintf(stderr, "%-26s %-13s %9zu %10.1f ns/process\n",
+                    m.algorithm.c_str(), m.workload.c_str(), n, m.nsPerProcess);
+
+                if (n == GROWTH_REFERENCE_SIZE)
+                    reference[algo] = m.nsPerProcess;
+                if (n > GROWTH_REFERENCE_SIZE && n * 10 > maxSize && reference.count(algo)
+                    && m.nsPerProcess > reference[algo] * maxGrowth) {
+                    regressions.push_back(m.algorithm + " on " + m.workload + ": ns per process grew "
+                        + to_string(m.nsPerProcess / reference[algo]) + "x from 10^4 to " + to_string(n) + " processes");
+                }
+
+                auto it = baseline.find(m.algorithm + "/" + m.workload + "/" + to_string(n));
+                if (n >= GROWTH_REFERENCE_SIZE && it != baseline.end() && m.nsPerProcess > it->second * tolerance) {
+                    regressions.push_back(m.algorithm + " on " + m.workload + " at " + to_string(n) + " processes: "
+                        + to_string(m.nsPerProcess) + " ns per process vs baseline " + to_string(it->second));
+                }
+            }
+        }
+    }
+
+    printf("{\"benchmark\":\"schedulers\",\"quantum\":%d,\"results\":[\n", timeQuantum);
+    for (size_t i = 0; i < results.size(); i++) {
+        const Measurement& m = results[i];
+        printf("{\"algorithm\":\"%s\",\"workload\":\"%s\",\"processes\":%zu,\"ns_per_process\":%.3f,"
+            "\"peak_bytes\":%lld,\"steady_bytes\":%lld,\"sim_per_wall_second\":%.0f}%s\n",
+            m.algorithm.c_str(), m.workload.c_str(), m.processes, m.nsPerProcess,
+            m.peakBytes, m.steadyBytes, m.simPerWallSecond, i + 1 < results.size() ? "," : "");
+    }
+    printf("],\"regressions\":[");
+    for (size_t i = 0; i < regressions.size(); i++) {
+        printf("%s\n\"%s\"", i ? "," : "", regressions[i].c_str());
+        fprintf(stderr, "[REGRESSION] %s\n", regressions[i].c_str());
+    }
+    printf("],\"passed\":%s}\n", regressions.empty() ? "true" : "false");
+    return regressions.empty() ? 0 : 1;
+}